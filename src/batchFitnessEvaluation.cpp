@@ -0,0 +1,163 @@
+#include "batchFitnessEvaluation.hpp"
+
+#if defined(__x86_64__)
+    #include <immintrin.h> // SSE2 and AVX2 intrinsics
+    #define BATCH_FITNESS_X86
+#endif
+
+// Scalar kernel: evaluates each board separately. It is used for the boards that do not fill a
+// whole SIMD register and on CPUs without SIMD support
+static void evaluate_fitness_of_boards_scalar(const uint8_t* boards, int nOfBoards, int firstBoard, int lastBoard, int* fitnessValues)
+{
+    for(int b = firstBoard; b < lastBoard; b++)
+    {
+        int fitnessValue = 0;
+
+        // For each unit, count the pairs of cells with the same value
+        for(int unit = 0; unit < SUDOKU_UNITS; unit++)
+        {
+            const auto& cells = sudokuTables.unitCells[unit];
+            for(int i = 0; i < SUDOKU_UNIT_SIZE; i++)
+                for(int j = i+1; j < SUDOKU_UNIT_SIZE; j++)
+                    fitnessValue += boards[cells[i] * nOfBoards + b] == boards[cells[j] * nOfBoards + b];
+        }
+
+        fitnessValues[b] = fitnessValue;
+    }
+}
+
+#if defined BATCH_FITNESS_X86
+
+// SSE2 kernel: evaluates 16 boards per iteration
+static int evaluate_fitness_of_boards_sse2(const uint8_t* boards, int nOfBoards, int firstBoard, int lastBoard, int* fitnessValues)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    int b = firstBoard;
+    for(; b + 16 <= lastBoard; b += 16)
+    {
+        // 16 bits accumulators for boards 0-7 and 8-15 of this iteration
+        __m128i fitnessLow = zero;
+        __m128i fitnessHigh = zero;
+
+        for(int unit = 0; unit < SUDOKU_UNITS; unit++)
+        {
+            const auto& cells = sudokuTables.unitCells[unit];
+
+            // Loads the 9 cells of the unit
+            __m128i values[SUDOKU_UNIT_SIZE];
+            for(int i = 0; i < SUDOKU_UNIT_SIZE; i++)
+                values[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(boards + cells[i] * nOfBoards + b));
+
+            // Counts the equal pairs on 8 bits (at most 36 per unit)
+            __m128i unitRepetitions = zero;
+            for(int i = 0; i < SUDOKU_UNIT_SIZE; i++)
+                for(int j = i+1; j < SUDOKU_UNIT_SIZE; j++)
+                    unitRepetitions = _mm_sub_epi8(unitRepetitions, _mm_cmpeq_epi8(values[i], values[j]));
+
+            // Widens them to 16 bits and accumulates them
+            fitnessLow = _mm_add_epi16(fitnessLow, _mm_unpacklo_epi8(unitRepetitions, zero));
+            fitnessHigh = _mm_add_epi16(fitnessHigh, _mm_unpackhi_epi8(unitRepetitions, zero));
+        }
+
+        // Stores the fitness values
+        alignas(16) uint16_t result[16];
+        _mm_store_si128(reinterpret_cast<__m128i*>(result), fitnessLow);
+        _mm_store_si128(reinterpret_cast<__m128i*>(result + 8), fitnessHigh);
+        for(int i = 0; i < 16; i++)
+            fitnessValues[b + i] = result[i];
+    }
+
+    // Returns the first board that has not been evaluated
+    return b;
+}
+
+// AVX2 kernel: evaluates 32 boards per iteration
+__attribute__((target("avx2")))
+static int evaluate_fitness_of_boards_avx2(const uint8_t* boards, int nOfBoards, int firstBoard, int lastBoard, int* fitnessValues)
+{
+    const __m256i zero = _mm256_setzero_si256();
+
+    int b = firstBoard;
+    for(; b + 32 <= lastBoard; b += 32)
+    {
+        // 16 bits accumulators. AVX2 unpacks work on each 128 bits lane, so fitnessLow holds boards
+        // 0-7 and 16-23 and fitnessHigh holds boards 8-15 and 24-31
+        __m256i fitnessLow = zero;
+        __m256i fitnessHigh = zero;
+
+        for(int unit = 0; unit < SUDOKU_UNITS; unit++)
+        {
+            const auto& cells = sudokuTables.unitCells[unit];
+
+            // Loads the 9 cells of the unit
+            __m256i values[SUDOKU_UNIT_SIZE];
+            for(int i = 0; i < SUDOKU_UNIT_SIZE; i++)
+                values[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(boards + cells[i] * nOfBoards + b));
+
+            // Counts the equal pairs on 8 bits (at most 36 per unit)
+            __m256i unitRepetitions = zero;
+            for(int i = 0; i < SUDOKU_UNIT_SIZE; i++)
+                for(int j = i+1; j < SUDOKU_UNIT_SIZE; j++)
+                    unitRepetitions = _mm256_sub_epi8(unitRepetitions, _mm256_cmpeq_epi8(values[i], values[j]));
+
+            // Widens them to 16 bits and accumulates them
+            fitnessLow = _mm256_add_epi16(fitnessLow, _mm256_unpacklo_epi8(unitRepetitions, zero));
+            fitnessHigh = _mm256_add_epi16(fitnessHigh, _mm256_unpackhi_epi8(unitRepetitions, zero));
+        }
+
+        // Stores the fitness values undoing the lane interleaving
+        alignas(32) uint16_t low[16];
+        alignas(32) uint16_t high[16];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(low), fitnessLow);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(high), fitnessHigh);
+        for(int i = 0; i < 8; i++)
+        {
+            fitnessValues[b + i] = low[i];
+            fitnessValues[b + 8 + i] = high[i];
+            fitnessValues[b + 16 + i] = low[8 + i];
+            fitnessValues[b + 24 + i] = high[8 + i];
+        }
+    }
+
+    // Returns the first board that has not been evaluated
+    return b;
+}
+
+// Whether the CPU supports AVX2 (checked only once)
+static bool cpu_supports_avx2()
+{
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+#endif
+
+// Function that calculates the fitness value of the boards firstBoard to lastBoard-1
+void evaluate_fitness_of_board_range(const uint8_t* boards, int nOfBoards, int firstBoard, int lastBoard, int* fitnessValues)
+{
+    int evaluatedBoards = firstBoard;
+
+    #if defined BATCH_FITNESS_X86
+        // Selects the kernel depending on the CPU
+        if(cpu_supports_avx2())
+            evaluatedBoards = evaluate_fitness_of_boards_avx2(boards, nOfBoards, evaluatedBoards, lastBoard, fitnessValues);
+
+        evaluatedBoards = evaluate_fitness_of_boards_sse2(boards, nOfBoards, evaluatedBoards, lastBoard, fitnessValues);
+    #endif
+
+    // The rest of boards are evaluated one by one
+    evaluate_fitness_of_boards_scalar(boards, nOfBoards, evaluatedBoards, lastBoard, fitnessValues);
+}
+
+// Function that returns the name of the instruction set selected at runtime
+const char* get_batch_fitness_instruction_set()
+{
+    #if defined BATCH_FITNESS_X86
+        if(cpu_supports_avx2())
+            return "AVX2";
+        return "SSE2";
+    #else
+        return "scalar";
+    #endif
+}
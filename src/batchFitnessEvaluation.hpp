@@ -0,0 +1,34 @@
+#pragma once // Multiple inclusion guardian
+
+#include <cstdint> // uint8_t
+
+#include "sudokuTables.hpp" // SUDOKU_CELLS
+
+/*
+
+Batch fitness evaluation:
+
+Functions that calculate the fitness value of many sudoku boards at once. The fitness value
+is the same as SDK_Individual::calculateFitnessValue() (sudokuProblemIndividual.hpp): the number
+of pairs of cells that share a value on each row, col and subgrid.
+
+Boards must be provided transposed (structure of arrays): the value of the cell c of the board
+b is at boards[c * nOfBoards + b]. That way, each SIMD register holds the same cell of 16 (SSE2)
+or 32 (AVX2) boards and each row, col and subgrid is evaluated for all of them with the same
+instructions:
+
+    - for each of the 36 pairs of cells of a unit, the values of both cells are compared and the
+      result (0 or -1 on each byte) is substracted from an accumulator
+
+The instruction set is selected at runtime (AVX2 if the CPU supports it, SSE2 if not), and a
+scalar implementation is used on non x86-64 CPUs and for the boards that do not fill a register.
+
+*/
+
+// Function that calculates the fitness value of the boards firstBoard to lastBoard-1 of nOfBoards
+// transposed boards (stored on fitnessValues), so that different ranges can be evaluated by
+// different threads
+void evaluate_fitness_of_board_range(const uint8_t* boards, int nOfBoards, int firstBoard, int lastBoard, int* fitnessValues);
+
+// Function that returns the name of the instruction set selected at runtime
+const char* get_batch_fitness_instruction_set();
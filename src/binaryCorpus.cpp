@@ -0,0 +1,285 @@
+#include "binaryCorpus.hpp"
+
+#include <iostream> // std::cout, std::endl
+#include <cstring> // std::memcmp
+
+#include <fcntl.h> // open
+#include <unistd.h> // close
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat
+
+#include "sudokuTables.hpp" // SUDOKU_CELLS
+#include "sudokuStreamReader.hpp" // SudokuStreamReader
+
+// Magic number and version of the format
+static const char BINARY_CORPUS_MAGIC[4] = {'S', 'D', 'K', 'C'};
+static const uint32_t BINARY_CORPUS_VERSION = 1;
+
+// Functions that read and write little endian integers on unaligned memory
+
+static uint32_t read_uint32(const uint8_t* data)
+{
+    return uint32_t(data[0]) | uint32_t(data[1]) << 8 | uint32_t(data[2]) << 16 | uint32_t(data[3]) << 24;
+}
+
+static uint64_t read_uint64(const uint8_t* data)
+{
+    return uint64_t(read_uint32(data)) | uint64_t(read_uint32(data + 4)) << 32;
+}
+
+static void write_uint32(uint8_t* data, uint32_t value)
+{
+    for(int i = 0; i < 4; i++)
+        data[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+static void write_uint64(uint8_t* data, uint64_t value)
+{
+    write_uint32(data, static_cast<uint32_t>(value));
+    write_uint32(data + 4, static_cast<uint32_t>(value >> 32));
+}
+
+// Function that packs the values of 81 cells (given by getValue(cell)) on nibbles
+template <class GetValue>
+static void pack_puzzle(uint8_t* data, GetValue getValue)
+{
+    for(std::size_t i = 0; i < BINARY_PUZZLE_SIZE; i++)
+        data[i] = 0;
+    for(int cell = 0; cell < SUDOKU_CELLS; cell++)
+        data[cell >> 1] |= static_cast<uint8_t>((getValue(cell) & 0x0F) << ((cell & 1) * 4));
+}
+
+// BINARY PUZZLE AND RESULT VIEWS //
+
+// Stores the values of the 81 cells
+void BinaryPuzzleView::unpack(std::vector<int>& cells) const
+{
+    cells.resize(SUDOKU_CELLS);
+    for(int cell = 0; cell < SUDOKU_CELLS; cell++)
+        cells[cell] = getCellValue(cell);
+}
+
+// Getter for the generations of the result
+int BinaryResultView::getGenerations() const
+{
+    return static_cast<int>(read_uint32(data + BINARY_PUZZLE_SIZE + 1));
+}
+
+// Getter for the milliseconds of the result
+long BinaryResultView::getMilliseconds() const
+{
+    return static_cast<long>(read_uint32(data + BINARY_PUZZLE_SIZE + 5));
+}
+
+// BINARY CORPUS READER //
+
+// Constructor
+BinaryCorpusReader::BinaryCorpusReader():
+m_data(nullptr), m_size(0), m_nOfPuzzles(0), m_resultsOffset(0)
+{
+}
+
+// Destructor
+BinaryCorpusReader::~BinaryCorpusReader()
+{
+    close();
+}
+
+// Maps a binary corpus file
+bool BinaryCorpusReader::open(const std::string& binaryCorpusFilePath)
+{
+    close();
+
+    int fileDescriptor = ::open(binaryCorpusFilePath.c_str(), O_RDONLY);
+    if(fileDescriptor < 0)
+    {
+        std::cout << "Cannot open binary corpus file in:\n" << binaryCorpusFilePath << std::endl;
+        return false;
+    }
+
+    // The file is mapped as a whole. The mapping remains valid after closing the descriptor
+    struct stat fileStatus;
+    void* mapping = MAP_FAILED;
+    if(fstat(fileDescriptor, &fileStatus) == 0 && fileStatus.st_size >= static_cast<off_t>(BINARY_CORPUS_HEADER_SIZE))
+        mapping = mmap(nullptr, fileStatus.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    ::close(fileDescriptor);
+
+    if(mapping == MAP_FAILED)
+    {
+        std::cout << "Cannot map binary corpus file in:\n" << binaryCorpusFilePath << std::endl;
+        return false;
+    }
+
+    m_data = static_cast<const uint8_t*>(mapping);
+    m_size = fileStatus.st_size;
+
+    // Sudokus are read in order
+    madvise(mapping, m_size, MADV_SEQUENTIAL);
+
+    // Checks the header and that the file is large enough for the sudokus and results it declares
+    m_nOfPuzzles = read_uint64(m_data + 8);
+    m_resultsOffset = read_uint64(m_data + 16);
+    uint64_t puzzlesEnd = BINARY_CORPUS_HEADER_SIZE + m_nOfPuzzles * BINARY_PUZZLE_SIZE;
+    bool isValid = std::memcmp(m_data, BINARY_CORPUS_MAGIC, 4) == 0 &&
+                   read_uint32(m_data + 4) == BINARY_CORPUS_VERSION &&
+                   read_uint32(m_data + 24) == BINARY_PUZZLE_SIZE &&
+                   read_uint32(m_data + 28) == BINARY_RESULT_SIZE &&
+                   m_nOfPuzzles <= (m_size - BINARY_CORPUS_HEADER_SIZE) / BINARY_PUZZLE_SIZE;
+    if(isValid && m_resultsOffset != 0)
+        isValid = m_resultsOffset >= puzzlesEnd && m_resultsOffset <= m_size &&
+                  m_nOfPuzzles <= (m_size - m_resultsOffset) / BINARY_RESULT_SIZE;
+
+    if(!isValid)
+    {
+        std::cout << "The file is not a valid binary corpus:\n" << binaryCorpusFilePath << std::endl;
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+// Checks whether the file starts as a binary corpus
+bool BinaryCorpusReader::isBinaryCorpus(const std::string& filePath)
+{
+    std::ifstream file(filePath, std::ios::binary);
+    char magic[4];
+    return file.read(magic, 4) && std::memcmp(magic, BINARY_CORPUS_MAGIC, 4) == 0;
+}
+
+// Getter for the number of sudokus
+uint64_t BinaryCorpusReader::getNumberOfPuzzles() const
+{
+    return m_nOfPuzzles;
+}
+
+// View of a sudoku
+BinaryPuzzleView BinaryCorpusReader::getPuzzle(uint64_t puzzle) const
+{
+    return BinaryPuzzleView{m_data + BINARY_CORPUS_HEADER_SIZE + puzzle * BINARY_PUZZLE_SIZE};
+}
+
+// Whether the file has a results section
+bool BinaryCorpusReader::hasResults() const
+{
+    return m_resultsOffset != 0;
+}
+
+// View of the result of a sudoku
+BinaryResultView BinaryCorpusReader::getResult(uint64_t puzzle) const
+{
+    return BinaryResultView{m_data + m_resultsOffset + puzzle * BINARY_RESULT_SIZE};
+}
+
+// Unmaps the file
+void BinaryCorpusReader::close()
+{
+    if(m_data != nullptr)
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+
+    m_data = nullptr;
+    m_size = 0;
+    m_nOfPuzzles = 0;
+    m_resultsOffset = 0;
+}
+
+// BINARY CORPUS WRITER //
+
+// Constructor
+BinaryCorpusWriter::BinaryCorpusWriter(const std::string& binaryCorpusFilePath):
+m_file(binaryCorpusFilePath, std::ios::binary | std::ios::trunc), m_nOfPuzzles(0), m_nOfResults(0)
+{
+    // Space for the header, which is written when the number of sudokus is known
+    uint8_t header[BINARY_CORPUS_HEADER_SIZE] = {};
+    m_file.write(reinterpret_cast<const char*>(header), BINARY_CORPUS_HEADER_SIZE);
+}
+
+// Whether the file could be created
+bool BinaryCorpusWriter::isOpen() const
+{
+    return m_file.is_open();
+}
+
+// Writes a sudoku given the values of its cells
+void BinaryCorpusWriter::writePuzzle(const std::vector<int>& cells)
+{
+    uint8_t packedPuzzle[BINARY_PUZZLE_SIZE];
+    pack_puzzle(packedPuzzle, [&cells](int cell) { return cells[cell]; });
+    m_file.write(reinterpret_cast<const char*>(packedPuzzle), BINARY_PUZZLE_SIZE);
+    m_nOfPuzzles++;
+}
+
+// Writes a sudoku of another binary corpus
+void BinaryCorpusWriter::writePuzzle(BinaryPuzzleView puzzle)
+{
+    m_file.write(reinterpret_cast<const char*>(puzzle.data), BINARY_PUZZLE_SIZE);
+    m_nOfPuzzles++;
+}
+
+// Writes the result of the next sudoku
+void BinaryCorpusWriter::writeResult(bool solved, int generations, long milliseconds, const std::string& solution)
+{
+    uint8_t packedResult[BINARY_RESULT_SIZE];
+    pack_puzzle(packedResult, [&solution](int cell) { return cell < int(solution.size()) ? solution[cell] - '0' : 0; });
+    packedResult[BINARY_PUZZLE_SIZE] = solved;
+    write_uint32(packedResult + BINARY_PUZZLE_SIZE + 1, static_cast<uint32_t>(generations));
+    write_uint32(packedResult + BINARY_PUZZLE_SIZE + 5, static_cast<uint32_t>(milliseconds));
+    m_file.write(reinterpret_cast<const char*>(packedResult), BINARY_RESULT_SIZE);
+    m_nOfResults++;
+}
+
+// Writes the header and closes the file
+bool BinaryCorpusWriter::close()
+{
+    if(m_nOfResults != 0 && m_nOfResults != m_nOfPuzzles)
+    {
+        std::cout << "The binary corpus has " << m_nOfPuzzles << " sudokus but " << m_nOfResults << " results" << std::endl;
+        return false;
+    }
+
+    uint8_t header[BINARY_CORPUS_HEADER_SIZE];
+    std::memcpy(header, BINARY_CORPUS_MAGIC, 4);
+    write_uint32(header + 4, BINARY_CORPUS_VERSION);
+    write_uint64(header + 8, m_nOfPuzzles);
+    write_uint64(header + 16, m_nOfResults != 0 ? BINARY_CORPUS_HEADER_SIZE + m_nOfPuzzles * BINARY_PUZZLE_SIZE : 0);
+    write_uint32(header + 24, BINARY_PUZZLE_SIZE);
+    write_uint32(header + 28, BINARY_RESULT_SIZE);
+
+    m_file.seekp(0);
+    m_file.write(reinterpret_cast<const char*>(header), BINARY_CORPUS_HEADER_SIZE);
+    m_file.close();
+    return !m_file.fail();
+}
+
+// Function that converts a text corpus into a binary corpus
+long convert_text_corpus_to_binary(const std::string& textCorpusFilePath, const std::string& binaryCorpusFilePath)
+{
+    std::ifstream textCorpusFile(textCorpusFilePath);
+    if(!textCorpusFile.is_open())
+    {
+        std::cout << "Cannot open corpus file in:\n" << textCorpusFilePath << std::endl;
+        return -1;
+    }
+
+    BinaryCorpusWriter binaryCorpusWriter(binaryCorpusFilePath);
+    if(!binaryCorpusWriter.isOpen())
+    {
+        std::cout << "Cannot create binary corpus file in:\n" << binaryCorpusFilePath << std::endl;
+        return -1;
+    }
+
+    // Reads and writes one sudoku at a time
+    SudokuStreamReader sudokuStreamReader(textCorpusFile);
+    std::vector<int> cells;
+    long nOfPuzzles = 0;
+    while(sudokuStreamReader.readNextSudoku(cells))
+    {
+        binaryCorpusWriter.writePuzzle(cells);
+        nOfPuzzles++;
+    }
+
+    if(!binaryCorpusWriter.close())
+        return -1;
+
+    return nOfPuzzles;
+}
@@ -0,0 +1,153 @@
+#pragma once // Multiple inclusion guardian
+
+#include <cstdint> // uint8_t, uint32_t, uint64_t
+#include <cstddef> // std::size_t
+#include <fstream> // std::ofstream
+#include <string> // std::string
+#include <vector> // std::vector
+
+/*
+
+Binary corpus format:
+
+A compact format for corpora of millions of sudokus, that can be read without parsing any text nor
+copying the file into memory (it is mapped with mmap). All integers are little endian:
+
+    - Header (32 bytes):
+        - magic "SDKC" (4 bytes) and version (uint32)
+        - number of sudokus (uint64)
+        - offset of the results section, or 0 if the file has no results (uint64)
+        - size of each sudoku and of each result in bytes (uint32 each)
+    - Sudokus (41 bytes each): the 81 cells packed on nibbles, cell 2k on the low nibble of byte k and
+      cell 2k+1 on its high nibble (0 on the empty cells)
+    - Optional results section, with one result per sudoku (50 bytes each):
+        - solution (or best individual) packed as a sudoku (41 bytes)
+        - solved (uint8), generations (uint32) and milliseconds (uint32)
+
+BinaryCorpusWriter writes these files (text corpora are converted with convert_text_corpus_to_binary)
+and BinaryCorpusReader maps them and returns views of their sudokus and results, which point directly
+to the mapped memory.
+
+*/
+
+// Sizes of the parts of a binary corpus
+const std::size_t BINARY_CORPUS_HEADER_SIZE = 32;
+const std::size_t BINARY_PUZZLE_SIZE = 41;
+const std::size_t BINARY_RESULT_SIZE = 50;
+
+// View of a sudoku of a binary corpus (it does not own its memory)
+struct BinaryPuzzleView
+{
+    const uint8_t* data;
+
+    // Value of a cell (0 if it is empty)
+    int getCellValue(int cell) const
+    {
+        uint8_t packedCells = data[cell >> 1];
+        return (cell & 1) ? (packedCells >> 4) : (packedCells & 0x0F);
+    }
+
+    // Stores the values of the 81 cells on cells
+    void unpack(std::vector<int>& cells) const;
+};
+
+// View of the result of a sudoku of a binary corpus (it does not own its memory)
+struct BinaryResultView
+{
+    const uint8_t* data;
+
+    BinaryPuzzleView getSolution() const { return BinaryPuzzleView{data}; }
+    bool isSolved() const { return data[BINARY_PUZZLE_SIZE] != 0; }
+    int getGenerations() const;
+    long getMilliseconds() const;
+};
+
+class BinaryCorpusReader
+{
+
+// ATRIBUTES //
+
+private:
+
+    // Mapped file
+    const uint8_t* m_data;
+    std::size_t m_size;
+
+    // Values of the header
+    uint64_t m_nOfPuzzles;
+    uint64_t m_resultsOffset;
+
+// METHODS //
+
+public:
+
+    // Constructor and destructor (which unmaps the file)
+    BinaryCorpusReader();
+    ~BinaryCorpusReader();
+
+    // The mapping can not be copied
+    BinaryCorpusReader(const BinaryCorpusReader&) = delete;
+    BinaryCorpusReader& operator=(const BinaryCorpusReader&) = delete;
+
+    // Maps a binary corpus file. Returns false if it can not be read or it is not a valid binary corpus
+    bool open(const std::string& binaryCorpusFilePath);
+
+    // Returns true if the file starts as a binary corpus (it is used to choose the reader of a corpus)
+    static bool isBinaryCorpus(const std::string& filePath);
+
+    // Number of sudokus of the corpus
+    uint64_t getNumberOfPuzzles() const;
+
+    // View of a sudoku (valid while the reader exists)
+    BinaryPuzzleView getPuzzle(uint64_t puzzle) const;
+
+    // Whether the file has a results section, and view of the result of a sudoku
+    bool hasResults() const;
+    BinaryResultView getResult(uint64_t puzzle) const;
+
+private:
+
+    // Unmaps the file
+    void close();
+};
+
+class BinaryCorpusWriter
+{
+
+// ATRIBUTES //
+
+private:
+
+    // File that is being written
+    std::ofstream m_file;
+
+    // Number of sudokus and results written
+    uint64_t m_nOfPuzzles;
+    uint64_t m_nOfResults;
+
+// METHODS //
+
+public:
+
+    // Constructor that creates the file
+    explicit BinaryCorpusWriter(const std::string& binaryCorpusFilePath);
+    ~BinaryCorpusWriter() {}
+
+    // Whether the file could be created
+    bool isOpen() const;
+
+    // Writes a sudoku, given the values of its 81 cells or a view of another binary corpus
+    void writePuzzle(const std::vector<int>& cells);
+    void writePuzzle(BinaryPuzzleView puzzle);
+
+    // Writes the result of the next sudoku. Results are optional, but if they are written, it must be
+    // after all sudokus and there must be one per sudoku
+    void writeResult(bool solved, int generations, long milliseconds, const std::string& solution);
+
+    // Writes the header and closes the file. Returns false if the file is not valid
+    bool close();
+};
+
+// Function that converts a text corpus (any format read by SudokuStreamReader) into a binary corpus,
+// reading and writing one sudoku at a time. Returns the number of sudokus converted, or -1 on error
+long convert_text_corpus_to_binary(const std::string& textCorpusFilePath, const std::string& binaryCorpusFilePath);
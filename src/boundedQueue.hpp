@@ -0,0 +1,99 @@
+#pragma once // Multiple inclusion guardian
+
+#include <deque> // std::deque
+#include <mutex> // std::mutex, std::unique_lock
+#include <condition_variable> // std::condition_variable
+#include <cstddef> // std::size_t
+#include <utility> // std::move
+
+/*
+
+BoundedQueue class:
+
+A blocking queue with a maximum number of elements, for any number of producer and consumer threads.
+push() waits while the queue is full and pop() waits while it is empty, so a fast producer can never
+hold more than capacity elements in memory. When the producer has no more elements it calls close(),
+after which pop() returns the remaining elements and then false:
+
+    while(queue.pop(element)) { ... }
+
+It is used on the stream mode (streamSolver.hpp) to send the sudokus read from the input to the
+workers that solve them.
+
+It has only one template parameter:
+
+    template <class T>
+
+where T is the type of the elements, which must be move assignable.
+
+*/
+
+template <class T>
+class BoundedQueue
+{
+
+// ATRIBUTES //
+
+private:
+
+    // Elements of the queue and maximum number of them
+    std::deque<T> m_elements;
+    std::size_t m_capacity;
+
+    // true when no more elements will be pushed
+    bool m_closed;
+
+    // Mutex that protects the members above, and conditions that wake up producers and consumers
+    std::mutex m_mutex;
+    std::condition_variable m_notFullCondition;
+    std::condition_variable m_notEmptyCondition;
+
+// METHODS //
+
+public:
+
+    // Constructor that receives the maximum number of elements of the queue
+    explicit BoundedQueue(std::size_t capacity): m_capacity(capacity > 0 ? capacity : 1), m_closed(false) {}
+
+    // Adds an element at the end of the queue, waiting while it is full. Returns false if the queue
+    // has been closed
+    bool push(T element)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFullCondition.wait(lock, [this] { return m_closed || m_elements.size() < m_capacity; });
+        if(m_closed)
+            return false;
+
+        m_elements.push_back(std::move(element));
+        lock.unlock();
+        m_notEmptyCondition.notify_one();
+        return true;
+    }
+
+    // Takes the first element of the queue, waiting while it is empty. Returns false if the queue is
+    // empty and closed
+    bool pop(T& element)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmptyCondition.wait(lock, [this] { return m_closed || !m_elements.empty(); });
+        if(m_elements.empty())
+            return false;
+
+        element = std::move(m_elements.front());
+        m_elements.pop_front();
+        lock.unlock();
+        m_notFullCondition.notify_one();
+        return true;
+    }
+
+    // Closes the queue, waking up all threads that are waiting
+    void close()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_closed = true;
+        }
+        m_notFullCondition.notify_all();
+        m_notEmptyCondition.notify_all();
+    }
+};
@@ -0,0 +1,54 @@
+#pragma once // Multiple inclusion guardian
+
+#include <cstddef> // std::size_t
+#include <new> // operator new, std::align_val_t
+
+// Size of a cache line in bytes
+const std::size_t CACHE_LINE_SIZE = 64;
+
+/*
+
+CacheAlignedAllocator class:
+
+A minimal allocator template whose allocations always start at the beginning of a cache line. It is
+used as the allocator of the arrays of individuals (arrayOfIndividuals, population.hpp), so that the
+population arenas do not share their first and last cache lines with other data.
+
+It has only one template parameter:
+
+    template <class T>
+
+where T is the type of the elements that are allocated.
+
+*/
+
+template <class T>
+class CacheAlignedAllocator
+{
+public:
+
+    typedef T value_type;
+
+    // Standard constructors (it has no state)
+    CacheAlignedAllocator() noexcept {}
+    template <class U>
+    CacheAlignedAllocator(const CacheAlignedAllocator<U>&) noexcept {}
+
+    // Allocates memory for n elements, aligned to CACHE_LINE_SIZE
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(CACHE_LINE_SIZE)));
+    }
+
+    // Frees memory allocated by allocate()
+    void deallocate(T* p, std::size_t)
+    {
+        ::operator delete(p, std::align_val_t(CACHE_LINE_SIZE));
+    }
+};
+
+// As it has no state, all allocators are equal
+template <class T, class U>
+bool operator==(const CacheAlignedAllocator<T>&, const CacheAlignedAllocator<U>&) { return true; }
+template <class T, class U>
+bool operator!=(const CacheAlignedAllocator<T>&, const CacheAlignedAllocator<U>&) { return false; }
@@ -0,0 +1,182 @@
+#include "constraintPropagation.hpp"
+#include "utils.hpp" // ALL_SUDOKU_VALUES_MASK, sudoku_value_bit, count_values_bitmask
+
+// Function that sets the value of a cell and removes it from the candidates of its peers. Returns
+// false if a peer is left without candidates
+static bool assign_value(std::array<uint8_t, SUDOKU_CELLS>& values, std::array<uint16_t, SUDOKU_CELLS>& candidates,
+                         int cell, int value)
+{
+    uint16_t valueBit = sudoku_value_bit(value);
+    values[cell] = value;
+    candidates[cell] = valueBit;
+
+    for(int peer : sudokuTables.cellPeers[cell])
+    {
+        if(candidates[peer] & valueBit)
+        {
+            candidates[peer] &= ~valueBit;
+            if(candidates[peer] == 0)
+                return false;
+        }
+    }
+    return true;
+}
+
+// Function that removes a value from the candidates of the empty cells of a unit, except from the
+// ones that belong to another unit. Returns -1 if a cell is left without candidates, or the number of
+// candidates removed
+static int eliminate_value_from_unit(const std::array<uint8_t, SUDOKU_CELLS>& values, std::array<uint16_t, SUDOKU_CELLS>& candidates,
+                                     int unit, int exceptUnit, uint16_t valueBit)
+{
+    int nOfEliminations = 0;
+    for(int cell : sudokuTables.unitCells[unit])
+    {
+        if(values[cell] != 0 || !(candidates[cell] & valueBit))
+            continue;
+
+        // Cells of the unit that locks the value keep it
+        const auto& units = sudokuTables.cellUnits[cell];
+        if(units[0] == exceptUnit || units[1] == exceptUnit || units[2] == exceptUnit)
+            continue;
+
+        candidates[cell] &= ~valueBit;
+        if(candidates[cell] == 0)
+            return -1;
+        nOfEliminations++;
+    }
+    return nOfEliminations;
+}
+
+// Function that applies locked candidates to a unit: if all candidates of a value on the unit belong
+// to the same unit of the given type (row, col or subgrid), the value is removed from the rest of it.
+// Returns -1 on a contradiction, or the number of candidates removed
+static int apply_locked_candidates(const std::array<uint8_t, SUDOKU_CELLS>& values, std::array<uint16_t, SUDOKU_CELLS>& candidates,
+                                   int unit, int lockedUnitType, uint16_t placedValues)
+{
+    int nOfEliminations = 0;
+    for(int value = 1; value <= 9; value++)
+    {
+        uint16_t valueBit = sudoku_value_bit(value);
+        if(placedValues & valueBit)
+            continue;
+
+        // Unit of the given type of the candidates of the value (-1 if there are more than one)
+        int lockedUnit = -2;
+        for(int cell : sudokuTables.unitCells[unit])
+        {
+            if(values[cell] != 0 || !(candidates[cell] & valueBit))
+                continue;
+
+            int cellUnit = sudokuTables.cellUnits[cell][lockedUnitType];
+            lockedUnit = (lockedUnit == -2 || lockedUnit == cellUnit) ? cellUnit : -1;
+        }
+
+        if(lockedUnit >= 0 && lockedUnit != unit)
+        {
+            int nOfValueEliminations = eliminate_value_from_unit(values, candidates, lockedUnit, unit, valueBit);
+            if(nOfValueEliminations < 0)
+                return -1;
+            nOfEliminations += nOfValueEliminations;
+        }
+    }
+    return nOfEliminations;
+}
+
+// Function that deduces the empty cells that can be deduced
+int propagate_constraints(std::array<uint8_t, SUDOKU_CELLS>& values, std::array<uint16_t, SUDOKU_CELLS>& candidates)
+{
+    // Starts from an empty sudoku and assigns the initial values, which must be candidates of their cells
+    std::array<uint8_t, SUDOKU_CELLS> initialValues = values;
+    values.fill(0);
+    candidates.fill(ALL_SUDOKU_VALUES_MASK);
+    for(int cell = 0; cell < SUDOKU_CELLS; cell++)
+    {
+        int value = initialValues[cell];
+        if(value == 0)
+            continue;
+        if(!(candidates[cell] & sudoku_value_bit(value)) || !assign_value(values, candidates, cell, value))
+            return PROPAGATION_CONTRADICTION;
+    }
+
+    int nOfDeducedCells = 0;
+    bool changed = true;
+    while(changed)
+    {
+        changed = false;
+
+        // Naked singles
+        for(int cell = 0; cell < SUDOKU_CELLS; cell++)
+        {
+            if(values[cell] == 0 && count_values_bitmask(candidates[cell]) == 1)
+            {
+                if(!assign_value(values, candidates, cell, __builtin_ctz(candidates[cell])))
+                    return PROPAGATION_CONTRADICTION;
+                nOfDeducedCells++;
+                changed = true;
+            }
+        }
+
+        // Hidden singles, and values placed on each unit (used by locked candidates)
+        std::array<uint16_t, SUDOKU_UNITS> placedValues;
+        for(int unit = 0; unit < SUDOKU_UNITS; unit++)
+        {
+            for(int value = 1; value <= 9; value++)
+            {
+                uint16_t valueBit = sudoku_value_bit(value);
+                int nOfCandidateCells = 0;
+                int candidateCell = -1;
+                for(int cell : sudokuTables.unitCells[unit])
+                {
+                    if(candidates[cell] & valueBit)
+                    {
+                        nOfCandidateCells++;
+                        candidateCell = cell;
+                    }
+                }
+
+                // The value can not be placed on the unit
+                if(nOfCandidateCells == 0)
+                    return PROPAGATION_CONTRADICTION;
+
+                if(nOfCandidateCells == 1 && values[candidateCell] == 0)
+                {
+                    if(!assign_value(values, candidates, candidateCell, value))
+                        return PROPAGATION_CONTRADICTION;
+                    nOfDeducedCells++;
+                    changed = true;
+                }
+            }
+
+            placedValues[unit] = 0;
+            for(int cell : sudokuTables.unitCells[unit])
+                placedValues[unit] |= sudoku_value_bit(values[cell]);
+        }
+
+        // Locked candidates (only when singles have not changed anything, as they are cheaper)
+        if(changed)
+            continue;
+
+        for(int unit = 0; unit < SUDOKU_UNITS; unit++)
+        {
+            // Pointing (subgrids locking a row or a col) and claiming (rows and cols locking a subgrid)
+            int nOfEliminations = 0;
+            if(unit >= SUBGRID_UNITS_OFFSET)
+            {
+                for(int lockedUnitType = 0; lockedUnitType < 2 && nOfEliminations >= 0; lockedUnitType++)
+                {
+                    int nOfTypeEliminations = apply_locked_candidates(values, candidates, unit, lockedUnitType, placedValues[unit]);
+                    nOfEliminations = nOfTypeEliminations < 0 ? -1 : nOfEliminations + nOfTypeEliminations;
+                }
+            }
+            else
+                nOfEliminations = apply_locked_candidates(values, candidates, unit, 2, placedValues[unit]);
+
+            if(nOfEliminations < 0)
+                return PROPAGATION_CONTRADICTION;
+            if(nOfEliminations > 0)
+                changed = true;
+        }
+    }
+
+    return nOfDeducedCells;
+}
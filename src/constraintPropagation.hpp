@@ -0,0 +1,36 @@
+#pragma once // Multiple inclusion guardian
+
+#include <array> // std::array
+#include <cstdint> // uint8_t, uint16_t
+
+#include "sudokuTables.hpp" // SUDOKU_CELLS
+
+/*
+
+Constraint propagation:
+
+Functions that deduce the value of some empty cells of a sudoku with logical rules only, before the
+genetic algorithm is run. Candidates of each cell are bitmasks of values (as in utils.hpp), and the
+following rules are applied until none of them changes anything:
+
+    - naked singles: a cell with only one candidate takes that value
+    - hidden singles: a value that can only go in one cell of a unit is placed on that cell
+    - locked candidates: if the candidates of a value on a subgrid are all on the same row (or col),
+      the value is removed from the rest of that row (or col) (pointing), and if the candidates of a
+      value on a row (or col) are all on the same subgrid, the value is removed from the rest of that
+      subgrid (claiming)
+
+Deduced cells can then be fixed, so easy sudokus are solved without the genetic algorithm and hard
+ones are solved with a shorter genotype and tighter legal values for each gene (sudokuPuzzleContext.hpp).
+
+*/
+
+// Value returned by propagate_constraints when the sudoku has no solution (for instance, if a value
+// is repeated on a unit of the initial sudoku)
+const int PROPAGATION_CONTRADICTION = -1;
+
+// Function that completes values (0 on the empty cells) with the cells that can be deduced, and stores
+// the candidates left for each cell on candidates (only the bit of its value on the not empty ones).
+// Returns the number of cells deduced, or PROPAGATION_CONTRADICTION if the sudoku has no solution, in
+// which case values and candidates are not valid
+int propagate_constraints(std::array<uint8_t, SUDOKU_CELLS>& values, std::array<uint16_t, SUDOKU_CELLS>& candidates);
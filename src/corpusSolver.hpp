@@ -0,0 +1,320 @@
+#pragma once // Multiple inclusion guardian
+
+#include <vector> // std::vector
+#include <string> // std::string
+#include <memory> // std::unique_ptr
+#include <chrono> // time measures
+#include <fstream> // std::ifstream, std::ofstream
+#include <iostream> // std::cout, std::endl, std::ostream
+
+#include "workStealingPool.hpp" // WorkStealingPool
+#include "geneticAlgorithm.hpp" // GeneticAlgorithm::runOneGeneration
+#include "sudokuTables.hpp" // SUDOKU_CELLS
+#include "utils.hpp" // parse_sudoku_line
+#include "binaryCorpus.hpp" // BinaryCorpusReader, BinaryCorpusWriter
+
+/*
+
+CorpusSolver class:
+
+A class template that solves many sudokus (a corpus) with the genetic algorithm, running one of them
+on each task of a work-stealing pool (workStealingPool.hpp). Each worker creates its population only
+once and reuses it (and its memory) for all the sudokus it solves, changing only the sudoku and the
+random seed (randomSeed + number of the sudoku, so that the result of each sudoku does not depend on
+the worker that solves it).
+
+The corpus is a text file with one sudoku per line, written with 81 characters (digits, with '0' or '.'
+on the empty cells). Empty lines and lines that start with '#' are ignored. The result of each sudoku is
+written on one line of the results file:
+
+    number of the sudoku, solved (1 or 0), generations, milliseconds, solution (or best individual)
+
+The corpus can also be a binary corpus (binaryCorpus.hpp), which is mapped into memory instead of being
+parsed, and each sudoku is unpacked only when it is going to be solved. If the name of the results file
+ends with ".bin", results are written as a binary corpus with a results section instead of as text.
+
+It has the same template parameters as GeneticAlgorithm (geneticAlgorithm.hpp):
+
+    template <class PopulationObject, class IndividualClass, class FileParametersObject>
+
+*/
+
+// Result of solving one sudoku of the corpus
+struct CorpusPuzzleResult
+{
+    bool solved;
+    int generations;
+    long milliseconds;
+    std::string solution;
+};
+
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+class CorpusSolver
+{
+
+// ATRIBUTES //
+
+private:
+
+    // Member that represents the struct that holds all file parameters
+    FileParametersObject m_fileParameters;
+
+    // Values of the cells of all sudokus of a text corpus (SUDOKU_CELLS for each one)
+    std::vector<int> m_corpusCells;
+    int m_nOfPuzzles;
+
+    // Mapped binary corpus (only used if the corpus is a binary one)
+    BinaryCorpusReader m_binaryCorpus;
+    bool m_isBinaryCorpus;
+
+    // Result of each sudoku
+    std::vector<CorpusPuzzleResult> m_results;
+
+    // Population of each worker (created when the worker solves its first sudoku)
+    std::vector<std::unique_ptr<PopulationObject>> m_workerPopulations;
+
+// METHODS //
+
+public:
+
+    // Constructor that receives as parameter the FileParametersObject
+    CorpusSolver(FileParametersObject fileParameters);
+    // Standard destructor
+    ~CorpusSolver() {}
+
+    // Reads the corpus from a text or binary file. Returns false if it can not be read
+    bool readCorpus(const std::string& corpusFilePath);
+
+    // Solves all sudokus of the corpus
+    void solveCorpus();
+
+    // Writes the result of each sudoku on a file (a binary corpus if its name ends with ".bin")
+    void writeResults(const std::string& resultsFilePath) const;
+
+    // Getter for the results
+    const std::vector<CorpusPuzzleResult>& getResults() const;
+
+    // Solves one sudoku with a population that is created the first time and reused afterwards (it is
+    // also used by the stream mode, streamSolver.hpp)
+    static void solveSudoku(std::unique_ptr<PopulationObject>& population, const std::vector<int>& cells, int randomSeed,
+                            const FileParametersObject& fileParameters, CorpusPuzzleResult& result);
+
+    // Writes the result of one sudoku as a line of the results file
+    static void writeResult(std::ostream& resultsStream, long puzzle, const CorpusPuzzleResult& result);
+
+private:
+
+    // Solves one sudoku with the population of a worker
+    void solvePuzzle(int worker, int puzzle);
+
+    // Writes the sudokus and their results as a binary corpus
+    void writeBinaryResults(const std::string& resultsFilePath) const;
+};
+
+// Constructor
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+CorpusSolver<PopulationObject, IndividualClass, FileParametersObject>::
+CorpusSolver(FileParametersObject fileParameters)
+{
+    m_fileParameters = fileParameters;
+    m_nOfPuzzles = 0;
+    m_isBinaryCorpus = false;
+
+    // Parallelism is achieved solving many sudokus at the same time, so each population uses only
+    // one thread
+    m_fileParameters.numberOfThreads = 1;
+}
+
+// Reads the corpus
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+bool CorpusSolver<PopulationObject, IndividualClass, FileParametersObject>::
+readCorpus(const std::string& corpusFilePath)
+{
+    // Binary corpora are mapped, not read
+    if(BinaryCorpusReader::isBinaryCorpus(corpusFilePath))
+    {
+        if(!m_binaryCorpus.open(corpusFilePath))
+            return false;
+        m_isBinaryCorpus = true;
+        m_nOfPuzzles = m_binaryCorpus.getNumberOfPuzzles();
+        return true;
+    }
+
+    std::ifstream corpusFile(corpusFilePath);
+    if(!corpusFile.is_open())
+    {
+        std::cout << "Cannot open corpus file in:\n" << corpusFilePath << std::endl;
+        return false;
+    }
+
+    // Reads each line and appends its cells to m_corpusCells
+    std::string corpusLine;
+    std::vector<int> cells;
+    int lineNumber = 0;
+    while(std::getline(corpusFile, corpusLine))
+    {
+        lineNumber++;
+        if(corpusLine.empty() || corpusLine[0] == '#' || corpusLine == "\r")
+            continue;
+
+        if(!parse_sudoku_line(corpusLine, cells))
+        {
+            std::cout << "Line " << lineNumber << " of the corpus is not a sudoku. It is ignored" << std::endl;
+            continue;
+        }
+
+        m_corpusCells.insert(m_corpusCells.end(), cells.begin(), cells.end());
+    }
+
+    m_nOfPuzzles = m_corpusCells.size() / SUDOKU_CELLS;
+    return true;
+}
+
+// Solves all sudokus of the corpus
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+void CorpusSolver<PopulationObject, IndividualClass, FileParametersObject>::
+solveCorpus()
+{
+    WorkStealingPool workStealingPool(m_fileParameters.numberOfCorpusWorkers);
+
+    m_results.assign(m_nOfPuzzles, CorpusPuzzleResult());
+    m_workerPopulations.resize(workStealingPool.getNumberOfWorkers());
+
+    // Each task solves one sudoku
+    workStealingPool.run(m_nOfPuzzles, [this](int worker, int puzzle)
+    {
+        solvePuzzle(worker, puzzle);
+    });
+}
+
+// Solves one sudoku of the corpus
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+void CorpusSolver<PopulationObject, IndividualClass, FileParametersObject>::
+solvePuzzle(int worker, int puzzle)
+{
+    // Cells of the sudoku, solved with the population of the worker and the random seed of the sudoku
+    std::vector<int> puzzleCells;
+    if(m_isBinaryCorpus)
+        m_binaryCorpus.getPuzzle(puzzle).unpack(puzzleCells);
+    else
+        puzzleCells.assign(m_corpusCells.begin() + puzzle * SUDOKU_CELLS, m_corpusCells.begin() + (puzzle + 1) * SUDOKU_CELLS);
+    solveSudoku(m_workerPopulations[worker], puzzleCells, m_fileParameters.randomSeed + puzzle, m_fileParameters, m_results[puzzle]);
+}
+
+// Solves one sudoku
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+void CorpusSolver<PopulationObject, IndividualClass, FileParametersObject>::
+solveSudoku(std::unique_ptr<PopulationObject>& population, const std::vector<int>& cells, int randomSeed,
+            const FileParametersObject& fileParameters, CorpusPuzzleResult& result)
+{
+    auto ceroTime = std::chrono::steady_clock::now();
+
+    // Creates the population the first time, and reuses it afterwards
+    if(!population)
+    {
+        FileParametersObject puzzleParameters = fileParameters;
+        puzzleParameters.randomSeed = randomSeed;
+        population.reset(new PopulationObject(puzzleParameters, cells));
+        population->initializePopulation();
+    }
+    else
+        population->resetPuzzle(cells, randomSeed);
+
+    // Runs generations until the stop condition is satisfied (the same as GeneticAlgorithm's). If all
+    // cells are fixed (the sudoku is complete, or constraint propagation has fixed all of them), no
+    // generation can change the individuals, so the sudoku is reported as it is
+    int generation = 0;
+    int bestFitnessValue = population->getTheBestFitnessValue();
+    long elapsedMilliseconds = 0;
+    while(bestFitnessValue != 0 && population->getLengthOfTheGenotype() > 0)
+    {
+        generation++;
+        GeneticAlgorithm<PopulationObject, IndividualClass, FileParametersObject>::runOneGeneration(*population, generation);
+        bestFitnessValue = population->getTheBestFitnessValue();
+
+        elapsedMilliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now()-ceroTime).count();
+        if(generation >= fileParameters.maxGenerations && fileParameters.maxGenerations != 0)
+            break;
+        if(elapsedMilliseconds > 1000L * fileParameters.maxSecondsOfExecution && fileParameters.maxSecondsOfExecution != 0)
+            break;
+    }
+
+    // Stores the result
+    const IndividualClass& bestIndividual = population->getTheBestIndividual();
+    result.solved = bestFitnessValue == 0;
+    result.generations = generation;
+    result.milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now()-ceroTime).count();
+    result.solution.resize(SUDOKU_CELLS);
+    for(int cell = 0; cell < SUDOKU_CELLS; cell++)
+        result.solution[cell] = '0' + bestIndividual.getCellValue(cell);
+}
+
+// Writes the results
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+void CorpusSolver<PopulationObject, IndividualClass, FileParametersObject>::
+writeResults(const std::string& resultsFilePath) const
+{
+    const std::string binaryExtension = ".bin";
+    if(resultsFilePath.size() >= binaryExtension.size() &&
+       resultsFilePath.compare(resultsFilePath.size() - binaryExtension.size(), binaryExtension.size(), binaryExtension) == 0)
+    {
+        writeBinaryResults(resultsFilePath);
+        return;
+    }
+
+    std::ofstream resultsFile(resultsFilePath);
+    if(!resultsFile.is_open())
+    {
+        std::cout << "Cannot open results file in:\n" << resultsFilePath << std::endl;
+        return;
+    }
+
+    for(int puzzle = 0; puzzle < m_nOfPuzzles; puzzle++)
+        writeResult(resultsFile, puzzle, m_results[puzzle]);
+}
+
+// Writes the sudokus and their results as a binary corpus
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+void CorpusSolver<PopulationObject, IndividualClass, FileParametersObject>::
+writeBinaryResults(const std::string& resultsFilePath) const
+{
+    BinaryCorpusWriter binaryCorpusWriter(resultsFilePath);
+    if(!binaryCorpusWriter.isOpen())
+    {
+        std::cout << "Cannot open results file in:\n" << resultsFilePath << std::endl;
+        return;
+    }
+
+    // All sudokus first, and then all results
+    for(int puzzle = 0; puzzle < m_nOfPuzzles; puzzle++)
+    {
+        if(m_isBinaryCorpus)
+            binaryCorpusWriter.writePuzzle(m_binaryCorpus.getPuzzle(puzzle));
+        else
+            binaryCorpusWriter.writePuzzle(std::vector<int>(m_corpusCells.begin() + puzzle * SUDOKU_CELLS, m_corpusCells.begin() + (puzzle + 1) * SUDOKU_CELLS));
+    }
+    for(int puzzle = 0; puzzle < m_nOfPuzzles; puzzle++)
+    {
+        const CorpusPuzzleResult& result = m_results[puzzle];
+        binaryCorpusWriter.writeResult(result.solved, result.generations, result.milliseconds, result.solution);
+    }
+
+    binaryCorpusWriter.close();
+}
+
+// Writes the result of one sudoku
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+void CorpusSolver<PopulationObject, IndividualClass, FileParametersObject>::
+writeResult(std::ostream& resultsStream, long puzzle, const CorpusPuzzleResult& result)
+{
+    resultsStream << puzzle << "," << result.solved << "," << result.generations << ","
+                  << result.milliseconds << "," << result.solution << "\n";
+}
+
+// Getter for the results
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+const std::vector<CorpusPuzzleResult>& CorpusSolver<PopulationObject, IndividualClass, FileParametersObject>::
+getResults() const
+{
+    return m_results;
+}
@@ -6,7 +6,9 @@
 
 FileParameters struct:
 
-A struct that groups all parameters that are read from the configuration file
+A struct that groups all parameters that are read from the configuration file. Parameters added after
+the first version of the file have default values, so that older configuration files (which do not
+have them) keep working as they did
 
 */
 
@@ -29,6 +31,55 @@ struct FileParameters
     int logEachXGenerations;
     // true if the problem is a maximization, false if it is a minimization
     bool maximizationProblem;
+    // true if the fitness values of the descendency are calculated on batches with SIMD instructions,
+    // false if they are updated incrementally each time a cell changes
+    bool batchFitnessEvaluation = false;
+    // Number of fitness values remembered on batch fitness evaluation (0 if it is not used)
+    int fitnessCacheSize = 0;
+    // Number of threads that run the recombination, mutation and evaluation of the descendency
+    // (0 means one thread per core)
+    int numberOfThreads = 1;
+    // true if the cells that can be deduced with constraint propagation are fixed before running the
+    // genetic algorithm
+    bool constraintPropagation = false;
+    // Representation of the individuals
+        // 0: values of the not fixed cells (SDK_Individual)
+        // 1: rows that are permutations of their missing values (SDK_RowPermutationIndividual)
+    int individualRepresentation = 0;
+
+    // CORPUS SETTINGS
+
+    // File with many sudokus to be solved (empty if only the sudoku of sudokuFilePath is solved)
+    std::string corpusFilePath;
+    // File where the result of each sudoku of the corpus is written
+    std::string corpusResultsFilePath = "corpus_results.txt";
+    // Number of workers that solve sudokus of the corpus at the same time (0 means one per core)
+    int numberOfCorpusWorkers = 0;
+    // Binary corpus into which the corpus is converted, without solving it (empty if it is solved)
+    std::string binaryCorpusFilePath;
+
+    // STREAM SETTINGS
+
+    // File from which sudokus are read and solved while they arrive ("-" for stdin, empty if the stream
+    // mode is not used). The number of workers is numberOfCorpusWorkers
+    std::string streamInputFilePath;
+    // File where the result of each sudoku of the stream is written as soon as it is solved ("-" for stdout)
+    std::string streamResultsFilePath = "-";
+    // Max number of sudokus read that are waiting to be solved
+    int streamQueueCapacity = 64;
+
+    // ISLAND MODEL SETTINGS
+
+    // Number of populations (islands) that evolve on different threads (1 if the island model is not used)
+    int numberOfIslands = 1;
+    // Number of generations between migrations
+    int migrationInterval = 50;
+    // Number of best individuals of each island that migrate on each migration
+    int numberOfMigrants = 2;
+    // Islands to which each island sends its migrants
+        // 0: ring (the next island)
+        // 1: fully connected (all islands)
+    int migrationTopology = 0;
 
     // PARENT SELECTION SETTINGS
 
@@ -49,9 +100,17 @@ struct FileParameters
     // Whether the tournament selection is excluding or not
     bool excludingTournament;
 
+    // Selection pressure of linear rank selection and proportion of the population that can be
+    // selected on truncation selection
+    float rankSelectionPressure = 1.5f;
+    float truncationProportion = 0.5f;
+
     // RECOMBINATIONS SETTINGS
     float pc_crossoverProb;
 
+    // Crossover method (0: one point, 1: uniform, 2: row-wise, 3: column-wise, 4: subgrid-wise)
+    int crossoverMethod = 0;
+
     // MUTATION SETTINGS
 
     // Probability of mutation
@@ -59,11 +118,29 @@ struct FileParameters
 
     int mutation_method;
 
+    // LOCAL SEARCH SETTINGS
+
+    // Number of best sons improved with local search on each generation (0 if it is not used)
+    int localSearchIndividuals = 0;
+    // Max number of steps of the local search of each son
+    int localSearchSteps = 1000;
+    // Number of steps during which the old value of a changed gene can not be taken again
+    int localSearchTabuTenure = 2;
+
     // SURVIVAL SELECTION SETTINGS
 
-    // 1 if it is a generational model (all sons replace all individuals), 0 if  not
+    // 1 if it is a generational model (all sons replace all individuals), 0 if it is a steady-state
+    // model (each son replaces one individual in place)
     bool generationalModel;
+    // Individual replaced by each son on the steady-state model (0: the worst one, 1: the loser of
+    // a tournament)
+    int steadyStateReplacement = 0;
+    // Survival strategy of the generational model (0: sons replace parents, 1: (mu+lambda),
+    // 2: (mu,lambda))
+    int survivalStrategy = 0;
     // 1 if elitism is applied, 0 if not
     bool elitism;
+    // Number of best individuals preserved with elitism
+    int numberOfElites = 1;
 
 };
@@ -139,6 +139,48 @@ void FileParametersReader::processLine(std::vector<std::string> line)
             m_fileParameters.logEachXGenerations = std::stoi(line.at(1));
         else if(line.at(0) == "maximizationProblem")
             m_fileParameters.maximizationProblem = std::stoi(line.at(1));
+        else if(line.at(0) == "batchFitnessEvaluation")
+            m_fileParameters.batchFitnessEvaluation = std::stoi(line.at(1));
+        else if(line.at(0) == "fitnessCacheSize")
+            m_fileParameters.fitnessCacheSize = std::stoi(line.at(1));
+        else if(line.at(0) == "numberOfThreads")
+            m_fileParameters.numberOfThreads = std::stoi(line.at(1));
+        else if(line.at(0) == "constraintPropagation")
+            m_fileParameters.constraintPropagation = std::stoi(line.at(1));
+        else if(line.at(0) == "individualRepresentation")
+            m_fileParameters.individualRepresentation = std::stoi(line.at(1));
+        else if(line.at(0) == "corpusFilePath")
+            m_fileParameters.corpusFilePath = "./data/sudokus/" + line.at(1);
+        else if(line.at(0) == "corpusResultsFilePath")
+            m_fileParameters.corpusResultsFilePath = line.at(1);
+        else if(line.at(0) == "numberOfCorpusWorkers")
+            m_fileParameters.numberOfCorpusWorkers = std::stoi(line.at(1));
+        else if(line.at(0) == "binaryCorpusFilePath")
+            m_fileParameters.binaryCorpusFilePath = "./data/sudokus/" + line.at(1);
+        else if(line.at(0) == "streamInputFilePath")
+            m_fileParameters.streamInputFilePath = line.at(1);
+        else if(line.at(0) == "streamResultsFilePath")
+            m_fileParameters.streamResultsFilePath = line.at(1);
+        else if(line.at(0) == "streamQueueCapacity")
+            m_fileParameters.streamQueueCapacity = std::stoi(line.at(1));
+        else if(line.at(0) == "numberOfIslands")
+        {
+            m_fileParameters.numberOfIslands = std::stoi(line.at(1));
+            // There is always at least one island
+            if(m_fileParameters.numberOfIslands < 1)
+                m_fileParameters.numberOfIslands = 1;
+        }
+        else if(line.at(0) == "migrationInterval")
+        {
+            m_fileParameters.migrationInterval = std::stoi(line.at(1));
+            // Migrations happen every migrationInterval generations, so it can not be lower than 1
+            if(m_fileParameters.migrationInterval < 1)
+                m_fileParameters.migrationInterval = 1;
+        }
+        else if(line.at(0) == "numberOfMigrants")
+            m_fileParameters.numberOfMigrants = std::stoi(line.at(1));
+        else if(line.at(0) == "migrationTopology")
+            m_fileParameters.migrationTopology = std::stoi(line.at(1));
         else if(line.at(0) == "parentSelectionMethod")
             m_fileParameters.parentSelectionMethod = std::stoi(line.at(1));
         else if(line.at(0) == "lambda_nOfParentsSelected")
@@ -147,11 +189,39 @@ void FileParametersReader::processLine(std::vector<std::string> line)
                 m_fileParameters.lambda_nOfParentsSelected = m_fileParameters.populationLength;
             else
                 m_fileParameters.lambda_nOfParentsSelected = std::stoi(line.at(1));
+            // If its a odd number, increase it by 1 so that is becomes a even
+            // number -> parents are recombined in pairs, each one giving two sons
+            if(m_fileParameters.lambda_nOfParentsSelected % 2 > 0)
+            {
+                m_fileParameters.lambda_nOfParentsSelected++;
+            }
         }
         else if(line.at(0) == "pc_crossoverProb")
             m_fileParameters.pc_crossoverProb = std::stof(line.at(1));
+        else if(line.at(0) == "crossoverMethod")
+            m_fileParameters.crossoverMethod = std::stoi(line.at(1));
         else if(line.at(0) == "gamma_tournamentSelection")
             m_fileParameters.gamma_tournamentSelection = std::stoi(line.at(1));
+        else if(line.at(0) == "rankSelectionPressure")
+        {
+            // Out of [1, 2], some weights of linear rank selection would be negative, so the value
+            // is rejected and the default one is kept
+            float rankSelectionPressure = std::stof(line.at(1));
+            if(rankSelectionPressure >= 1.0f && rankSelectionPressure <= 2.0f)
+                m_fileParameters.rankSelectionPressure = rankSelectionPressure;
+            else
+                std::cout << "rankSelectionPressure must be between 1 and 2, using " << m_fileParameters.rankSelectionPressure << std::endl;
+        }
+        else if(line.at(0) == "truncationProportion")
+        {
+            // Out of (0, 1], it is not a proportion of the population, so the value is rejected and
+            // the default one is kept
+            float truncationProportion = std::stof(line.at(1));
+            if(truncationProportion > 0.0f && truncationProportion <= 1.0f)
+                m_fileParameters.truncationProportion = truncationProportion;
+            else
+                std::cout << "truncationProportion must be greater than 0 and not greater than 1, using " << m_fileParameters.truncationProportion << std::endl;
+        }
         else if(line.at(0) == "p_bestParentSelectedProb")
             m_fileParameters.p_bestParentSelectedProb = std::stof(line.at(1));
         else if(line.at(0) == "excludingTournament")
@@ -160,10 +230,22 @@ void FileParametersReader::processLine(std::vector<std::string> line)
             m_fileParameters.pm_mutationProb = std::stof(line.at(1));
         else if(line.at(0) == "mutation_method")
             m_fileParameters.mutation_method = std::stoi(line.at(1));
+        else if(line.at(0) == "localSearchIndividuals")
+            m_fileParameters.localSearchIndividuals = std::stoi(line.at(1));
+        else if(line.at(0) == "localSearchSteps")
+            m_fileParameters.localSearchSteps = std::stoi(line.at(1));
+        else if(line.at(0) == "localSearchTabuTenure")
+            m_fileParameters.localSearchTabuTenure = std::stoi(line.at(1));
         else if(line.at(0) == "generationalModel")
             m_fileParameters.generationalModel = std::stoi(line.at(1));
+        else if(line.at(0) == "steadyStateReplacement")
+            m_fileParameters.steadyStateReplacement = std::stoi(line.at(1));
+        else if(line.at(0) == "survivalStrategy")
+            m_fileParameters.survivalStrategy = std::stoi(line.at(1));
         else if(line.at(0) == "elitism")
             m_fileParameters.elitism = std::stoi(line.at(1));
+        else if(line.at(0) == "numberOfElites")
+            m_fileParameters.numberOfElites = std::stoi(line.at(1));
 
     }
     
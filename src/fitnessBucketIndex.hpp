@@ -0,0 +1,239 @@
+#pragma once // Multiple inclusion guardian
+
+#include <vector> // std::vector
+#include <algorithm> // std::min, std::max, std::swap
+#include <type_traits> // std::is_integral
+
+/*
+
+FitnessBucketIndex class:
+
+An index of the individuals of an array ordered by their fitness value, from the best one (rank 0)
+to the worst one. As fitness values are small integers (the fitness value of a sudoku is at most a
+few hundreds), it is built with a counting sort: each individual is put on the bucket of its fitness
+value, and buckets are laid out one after another from the best fitness value to the worst one. So
+building it costs O(N + F), where F is the difference between the best and the worst fitness values,
+and no comparison sort is ever done:
+
+    bucketIndex.build(individuals, maximization);
+    int best = bucketIndex.getIndexOfRank(0);
+
+Individuals with the same fitness value keep their order on the array, so the best and the worst
+ones are the first ones of the array on draws. After that, the best and the worst individuals, the
+individual of any rank and the k best individuals are got in O(1).
+
+When the fitness value of a single individual changes (an individual replaced in place), the index
+is updated instead of built again:
+
+    bucketIndex.update(index, oldFitnessValue, newFitnessValue);
+
+The individual is moved bucket by bucket, swapping it with the first or the last individual of each
+bucket it goes through, so it costs O(B), where B is the number of buckets between both fitness values.
+After an update, individuals with the same fitness value may no longer keep their order on the array.
+
+It has only one template parameter:
+
+    template <class FitnessValueType>
+
+which is the type of the fitness values, and it must be an integer type to build the index.
+
+*/
+
+template <class FitnessValueType>
+class FitnessBucketIndex
+{
+
+// ATRIBUTES //
+
+private:
+
+    // Position (on m_sortedIndexes) of the first individual of each bucket. Bucket b holds the
+    // individuals whose fitness value is m_bestFitnessValue - b (maximization) or
+    // m_bestFitnessValue + b (minimization), and m_bucketStart has one more element at the end
+    std::vector<int> m_bucketStart;
+
+    // Positions of the individuals on the array, from the best one to the worst one
+    std::vector<int> m_sortedIndexes;
+
+    // Position on m_sortedIndexes of each individual of the array (the inverse of m_sortedIndexes)
+    std::vector<int> m_ranks;
+
+    // Best fitness value and whether greater fitness values are better
+    FitnessValueType m_bestFitnessValue;
+    bool m_maximization;
+
+// METHODS //
+
+public:
+
+    // Builds the index of an array of individuals (which must not be empty)
+    template <class ArrayOfIndividuals>
+    void build(const ArrayOfIndividuals& individuals, bool maximization)
+    {
+        static_assert(std::is_integral<FitnessValueType>::value, "Fitness values of a bucket index must be integers");
+
+        int nOfIndividuals = individuals.size();
+        m_maximization = maximization;
+
+        // Range of fitness values
+        FitnessValueType minFitnessValue = individuals[0].getFitnessValue();
+        FitnessValueType maxFitnessValue = minFitnessValue;
+        for(int i = 1; i < nOfIndividuals; i++)
+        {
+            minFitnessValue = std::min(minFitnessValue, individuals[i].getFitnessValue());
+            maxFitnessValue = std::max(maxFitnessValue, individuals[i].getFitnessValue());
+        }
+        m_bestFitnessValue = maximization ? maxFitnessValue : minFitnessValue;
+
+        // Number of individuals of each bucket (counted on the next position, so that the prefix sum
+        // gives the first position of each bucket)
+        int nOfBuckets = static_cast<int>(maxFitnessValue - minFitnessValue) + 1;
+        m_bucketStart.assign(nOfBuckets + 1, 0);
+        for(int i = 0; i < nOfIndividuals; i++)
+            m_bucketStart[getBucket(individuals[i].getFitnessValue()) + 1]++;
+        for(int bucket = 0; bucket < nOfBuckets; bucket++)
+            m_bucketStart[bucket + 1] += m_bucketStart[bucket];
+
+        // Puts each individual on the next free position of its bucket (m_bucketStart is used as the
+        // next free position of each bucket, so it ends up as the first position of the next bucket
+        // and it is shifted back afterwards)
+        m_sortedIndexes.resize(nOfIndividuals);
+        for(int i = 0; i < nOfIndividuals; i++)
+            m_sortedIndexes[m_bucketStart[getBucket(individuals[i].getFitnessValue())]++] = i;
+        for(int bucket = nOfBuckets; bucket > 0; bucket--)
+            m_bucketStart[bucket] = m_bucketStart[bucket - 1];
+        m_bucketStart[0] = 0;
+
+        m_ranks.resize(nOfIndividuals);
+        for(int rank = 0; rank < nOfIndividuals; rank++)
+            m_ranks[m_sortedIndexes[rank]] = rank;
+    }
+
+    // Moves an individual of the array whose fitness value has changed to the bucket of its new
+    // fitness value
+    void update(int index, FitnessValueType oldFitnessValue, FitnessValueType newFitnessValue)
+    {
+        // The new fitness value may be out of the range of the index
+        addBucketsUpTo(newFitnessValue);
+
+        int rank = m_ranks[index];
+        int oldBucket = getBucket(oldFitnessValue);
+        int newBucket = getBucket(newFitnessValue);
+
+        // If it is worse, it is swapped with the last individual of its bucket, which then ends one
+        // position before, so it becomes the first individual of the next bucket
+        for(int bucket = oldBucket; bucket < newBucket; bucket++)
+        {
+            int lastRankOfTheBucket = m_bucketStart[bucket + 1] - 1;
+            swapRanks(rank, lastRankOfTheBucket);
+            m_bucketStart[bucket + 1]--;
+            rank = lastRankOfTheBucket;
+        }
+
+        // If it is better, it is swapped with the first individual of its bucket, which then starts
+        // one position after, so it becomes the last individual of the previous bucket
+        for(int bucket = oldBucket; bucket > newBucket; bucket--)
+        {
+            int firstRankOfTheBucket = m_bucketStart[bucket];
+            swapRanks(rank, firstRankOfTheBucket);
+            m_bucketStart[bucket]++;
+            rank = firstRankOfTheBucket;
+        }
+
+        // The best and the worst buckets may have become empty
+        removeEmptyBucketsAtTheEnds();
+    }
+
+    // Number of individuals of the index
+    int size() const
+    {
+        return m_sortedIndexes.size();
+    }
+
+    // Position on the array of the individual of a rank (0 is the best one)
+    int getIndexOfRank(int rank) const
+    {
+        return m_sortedIndexes[rank];
+    }
+
+    // Positions of the best and the worst individuals (the first ones on the array on draws)
+    int getBestIndex() const
+    {
+        return m_sortedIndexes.front();
+    }
+    int getWorstIndex() const
+    {
+        return m_sortedIndexes[m_bucketStart[m_bucketStart.size() - 2]];
+    }
+
+    // Positions of all individuals from the best one to the worst one (the k best individuals are
+    // the first k ones)
+    const std::vector<int>& getSortedIndexes() const
+    {
+        return m_sortedIndexes;
+    }
+
+    // Number of individuals whose fitness value is better than a given one (that is to say, the rank
+    // of the first individual with that fitness value)
+    int getNumberOfBetterIndividuals(FitnessValueType fitnessValue) const
+    {
+        int bucket = getBucket(fitnessValue);
+        if(bucket < 0)
+            return 0;
+        if(bucket >= static_cast<int>(m_bucketStart.size()) - 1)
+            return size();
+        return m_bucketStart[bucket];
+    }
+
+private:
+
+    // Bucket of a fitness value
+    int getBucket(FitnessValueType fitnessValue) const
+    {
+        return static_cast<int>(m_maximization ? m_bestFitnessValue - fitnessValue : fitnessValue - m_bestFitnessValue);
+    }
+
+    // Swaps the individuals of two ranks
+    void swapRanks(int rankA, int rankB)
+    {
+        std::swap(m_sortedIndexes[rankA], m_sortedIndexes[rankB]);
+        m_ranks[m_sortedIndexes[rankA]] = rankA;
+        m_ranks[m_sortedIndexes[rankB]] = rankB;
+    }
+
+    // Adds empty buckets before the best one or after the worst one until there is a bucket for a
+    // fitness value
+    void addBucketsUpTo(FitnessValueType fitnessValue)
+    {
+        int bucket = getBucket(fitnessValue);
+        int nOfBuckets = m_bucketStart.size() - 1;
+        if(bucket < 0)
+        {
+            // The new buckets start at the first rank, and the fitness value becomes the best one
+            m_bucketStart.insert(m_bucketStart.begin(), -bucket, 0);
+            m_bestFitnessValue = fitnessValue;
+        }
+        else if(bucket >= nOfBuckets)
+        {
+            // The new buckets start after the last rank
+            m_bucketStart.resize(bucket + 2, size());
+        }
+    }
+
+    // Removes the empty buckets before the first individual and after the last one, so that the
+    // first and the last buckets are the ones of the best and the worst individuals
+    void removeEmptyBucketsAtTheEnds()
+    {
+        while(m_bucketStart.size() > 2 && m_bucketStart[m_bucketStart.size() - 2] == size())
+            m_bucketStart.pop_back();
+
+        int nOfEmptyBuckets = 0;
+        while(nOfEmptyBuckets < static_cast<int>(m_bucketStart.size()) - 2 && m_bucketStart[nOfEmptyBuckets + 1] == 0)
+            nOfEmptyBuckets++;
+        if(nOfEmptyBuckets > 0)
+        {
+            m_bucketStart.erase(m_bucketStart.begin(), m_bucketStart.begin() + nOfEmptyBuckets);
+            m_bestFitnessValue = m_maximization ? m_bestFitnessValue - nOfEmptyBuckets : m_bestFitnessValue + nOfEmptyBuckets;
+        }
+    }
+};
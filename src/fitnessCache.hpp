@@ -0,0 +1,103 @@
+#pragma once // Multiple inclusion guardian
+
+#include <vector> // std::vector
+#include <cstdint> // uint64_t
+
+/*
+
+FitnessCache class:
+
+A small direct-mapped cache of fitness values indexed by the hash of a genotype (for instance, the
+Zobrist hash of SDK_Individual, sudokuProblemIndividual.hpp). Each hash can only be stored on one
+slot (its low bits), and a new hash simply overwrites the previous one of its slot, so both lookup()
+and insert() are O(1) and the cache never allocates memory after it has been created.
+
+It is used on batch fitness evaluation (sudokuProblemPopulation.hpp), so that sons whose genotype
+has already been evaluated (copies of their parents, duplicates, ...) are not evaluated again. As
+hashes depend on the sudoku being solved, it must be cleared when the sudoku changes.
+
+It has only one template parameter:
+
+    template <class FitnessValueType>
+
+which is the type of the fitness values stored.
+
+*/
+
+template <class FitnessValueType>
+class FitnessCache
+{
+
+// ATRIBUTES //
+
+private:
+
+    // Slot of the cache: hash of the genotype, its fitness value and whether it is used
+    struct Entry
+    {
+        uint64_t hash;
+        FitnessValueType fitnessValue;
+        bool used;
+    };
+
+    // Slots of the cache (a power of two, so that the slot of a hash is hash & m_indexMask)
+    std::vector<Entry> m_entries;
+    uint64_t m_indexMask;
+
+// METHODS //
+
+public:
+
+    // Constructor that receives the number of slots (rounded up to a power of two). 0 means that
+    // the cache is disabled
+    explicit FitnessCache(int nOfSlots = 0)
+    {
+        int capacity = 1;
+        while(capacity < nOfSlots)
+            capacity *= 2;
+
+        if(nOfSlots > 0)
+            m_entries.resize(capacity);
+        m_indexMask = capacity - 1;
+        clear();
+    }
+
+    // Whether the cache is used or not
+    bool isEnabled() const
+    {
+        return !m_entries.empty();
+    }
+
+    // Removes every fitness value of the cache
+    void clear()
+    {
+        for(Entry& entry : m_entries)
+            entry.used = false;
+    }
+
+    // Gets the fitness value of a hash. Returns false if it is not on the cache
+    bool lookup(uint64_t hash, FitnessValueType& fitnessValue) const
+    {
+        if(m_entries.empty())
+            return false;
+
+        const Entry& entry = m_entries[hash & m_indexMask];
+        if(!entry.used || entry.hash != hash)
+            return false;
+
+        fitnessValue = entry.fitnessValue;
+        return true;
+    }
+
+    // Stores the fitness value of a hash (replacing the one that was on its slot)
+    void insert(uint64_t hash, FitnessValueType fitnessValue)
+    {
+        if(m_entries.empty())
+            return;
+
+        Entry& entry = m_entries[hash & m_indexMask];
+        entry.hash = hash;
+        entry.fitnessValue = fitnessValue;
+        entry.used = true;
+    }
+};
@@ -2,6 +2,14 @@
 
 #include <vector> // std::vector
 #include <chrono> // time measures
+#include <algorithm> // std::max
+#include <memory> // std::unique_ptr
+#include <thread> // std::thread
+#include <atomic> // std::atomic
+#include <mutex> // std::mutex, std::lock_guard
+#include <iostream> // std::cout, std::endl
+
+#include "spscQueue.hpp" // SpscQueue
 
 /*
 
@@ -20,6 +28,17 @@ IndividualClass represents the individual of the problem (class that inherits fr
 Individual (individual.hpp)) and FileParametersObject represents a class/struct that
 contains all parameters that are read from a configuration file
 
+If numberOfIslands is greater than 1, the island model is used: each island is an independent
+population (seeded with randomSeed + island) that evolves on its own thread (so numberOfThreads is
+not used) and shares the context of the sudoku with the rest of islands. Every migrationInterval
+generations, each island sends copies of its numberOfMigrants best individuals to its neighbours
+(the next island on a ring topology, all of them on a fully connected one) through lock-free single
+producer single consumer queues, and the migrants it receives replace its worst individuals. All
+islands stop as soon as one of them solves the sudoku (atomic flag) or when the stop condition is
+satisfied, and the best individual of all islands is the solution. As migrations depend on the
+timing of the threads, runs of the island model are not reproducible. The historical of best and
+average fitness values is the one of island 0.
+
 */
 
 template <class PopulationObject, class IndividualClass, class FileParametersObject>
@@ -30,9 +49,15 @@ class GeneticAlgorithm
 
 private:
 
-    // Dynamic PopulationObject that represents the population
+    // Populations of each island (only one if the island model is not used) and pointer to the
+    // first one, which is the population used when the island model is not used
+    std::vector<std::unique_ptr<PopulationObject>> m_islands;
     PopulationObject *m_population;
 
+    // Queues of migrants between islands. The queue from island src to island dst is at
+    // dst * numberOfIslands + src (nullptr if there is no migration between them)
+    std::vector<std::unique_ptr<SpscQueue<IndividualClass>>> m_migrationQueues;
+
     // Member that represents the struct that holds all file parameters
     FileParametersObject m_fileParameters;
 
@@ -78,6 +103,14 @@ public:
 
     // Method that runs one generation
     void runOneGeneration();
+    static void runOneGeneration(PopulationObject& population, int generation);
+
+    // Methods of the island model: runs all islands, runs one of them (on its own thread), sends and
+    // receives the migrants of one island and checks whether src sends migrants to dst
+    void runIslandModel();
+    void runIsland(int island, std::atomic<bool>& solved, std::mutex& logMutex, int& generationReached);
+    void migrate(int island, std::vector<int>& migrantIndexes, IndividualClass& immigrant);
+    bool isMigrationRoute(int src, int dst) const;
 
     // Method that checks if the stop condition is satisfied or not
     bool checkStopCondition();
@@ -89,14 +122,14 @@ public:
     int getGeneration();
 
     // Getter for the solution (or the best solution) get
-    IndividualClass getSolution();
+    const IndividualClass& getSolution() const;
 
     // Method that prints m_solution on stdout
     void printReachedSolution();
 
     // Geters for m_bestIndividualOfEachGen and m_avgIndividualOfEachGen
-    std::vector<int> getBestIndividualsPerGenArray();
-    std::vector<float> getAvgIndividualsPerGenArray();
+    const std::vector<int>& getBestIndividualsPerGenArray() const;
+    const std::vector<float>& getAvgIndividualsPerGenArray() const;
 
 };
 
@@ -112,6 +145,7 @@ GeneticAlgorithm(FileParametersObject fileParameters, std::vector<int> initialSu
     // Initialized the rest of members that need to be
     m_solutionFind = false;
     m_generation = 0;
+    m_elapsedTime = 0;
 
     // Set the time 0
     m_ceroTime = std::chrono::steady_clock::now();
@@ -122,12 +156,34 @@ template <class PopulationObject, class IndividualClass, class FileParametersObj
 void GeneticAlgorithm<PopulationObject, IndividualClass, FileParametersObject>::
 initializePopulation()
 {
+    int nOfIslands = std::max(1, m_fileParameters.numberOfIslands);
 
-    // Instaciates the dynamic PopulationObject
-    m_population = new PopulationObject(m_fileParameters, m_initialSudokuCells);
+    // Instaciates the dynamic PopulationObject of each island (each one with a different random seed)
+    // and initializes it. The first island builds the context of the sudoku and the rest of them
+    // share it, so that migrants are valid on any island. Parallelism of the island model is achieved
+    // running each island on its own thread, so each island uses only one thread
+    for(int island = 0; island < nOfIslands; island++)
+    {
+        FileParametersObject islandParameters = m_fileParameters;
+        islandParameters.randomSeed = m_fileParameters.randomSeed + island;
+        if(nOfIslands > 1)
+            islandParameters.numberOfThreads = 1;
 
-    // Initializes it
-    m_population->initializePopulation();
+        if(island == 0)
+            m_islands.emplace_back(new PopulationObject(islandParameters, m_initialSudokuCells));
+        else
+            m_islands.emplace_back(new PopulationObject(islandParameters, m_islands[0]->getPuzzleContext()));
+        m_islands.back()->initializePopulation();
+    }
+    m_population = m_islands[0].get();
+
+    // Creates the queues of migrants of each migration route. Each queue can hold the migrants of
+    // two migrations, as the receiver may not have taken the previous ones yet
+    m_migrationQueues.resize(nOfIslands * nOfIslands);
+    for(int dst = 0; dst < nOfIslands; dst++)
+        for(int src = 0; src < nOfIslands; src++)
+            if(isMigrationRoute(src, dst))
+                m_migrationQueues[dst * nOfIslands + src].reset(new SpscQueue<IndividualClass>(2 * m_fileParameters.numberOfMigrants));
 }
 
 // Method that runs the genetic algorithm
@@ -135,6 +191,34 @@ template <class PopulationObject, class IndividualClass, class FileParametersObj
 void GeneticAlgorithm<PopulationObject, IndividualClass, FileParametersObject>::
 runGeneticAlgorithm()
 {
+    // If the best individual is already a solution (for instance, because constraint propagation has
+    // solved the sudoku), no generation is run
+    if(m_population->getTheBestFitnessValue() == 0)
+    {
+        checkStopCondition();
+        return;
+    }
+
+    // If all cells are fixed but the sudoku is not valid (for instance, a complete sudoku with
+    // repeated values), no generation can change the individuals
+    if(m_population->getLengthOfTheGenotype() == 0)
+    {
+        std::cout << "All cells are fixed. NO SOLUTION FOUND\n";
+        m_solution = m_population->getTheBestIndividual();
+
+        // Prints the best individual on the screen
+        std::cout << "Best individual:\n";
+        printReachedSolution();
+        return;
+    }
+
+    // With more than one island, the island model is used
+    if(m_islands.size() > 1)
+    {
+        runIslandModel();
+        return;
+    }
+
     do
     {
         // Updates the generation number
@@ -143,16 +227,19 @@ runGeneticAlgorithm()
         // Runs one generation until the stop condition is satisfied
         runOneGeneration();
 
-        // Gets best and average fitness of the gen and adds it to the corresponding array
-        int bestFitnessValue = this->m_population->getTheBestFitnessValue();
-        float avgFitnessValue = this->m_population->getAverageFitnessValue();
+        // Gets best and average fitness of the gen (calculated once per generation and shared with
+        // the stop condition) and adds it to the corresponding array
+        const auto& statistics = this->m_population->getStatistics();
+        int bestFitnessValue = statistics.bestFitnessValue;
+        float avgFitnessValue = statistics.averageFitnessValue;
         m_bestIndividualOfEachGen.push_back(bestFitnessValue);
         m_avgIndividualOfEachGen.push_back(avgFitnessValue);
 
         // Writes a log on stdout
         if(m_generation % m_fileParameters.logEachXGenerations == 0)
             std::cout << "Generation number " << m_generation << " finished.\n\tBest individuals fitness = " << bestFitnessValue
-            << "\n\tAverage fitness value = " << avgFitnessValue << std::endl << std::endl;
+            << "\n\tAverage fitness value = " << avgFitnessValue
+            << "\n\tFitness variance = " << statistics.fitnessVariance << std::endl << std::endl;
 
         // Update elapsed time
         auto time = std::chrono::steady_clock::now();
@@ -168,24 +255,177 @@ template <class PopulationObject, class IndividualClass, class FileParametersObj
 void GeneticAlgorithm<PopulationObject, IndividualClass, FileParametersObject>::
 runOneGeneration()
 {
-    // Initialized parents and descendency arrays
-    std::vector<IndividualClass> parentsArray, descendencyArray;
+    runOneGeneration(*m_population, m_generation);
+}
 
-    // Parent selection
-    parentsArray = m_population->selectParentsFromPopulation();
+// Method that runs one generation of a population
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+void GeneticAlgorithm<PopulationObject, IndividualClass, FileParametersObject>::
+runOneGeneration(PopulationObject& population, int generation)
+{
+    // Parent selection (indexes of the parents on the current population)
+    population.selectParentsFromPopulation();
 
-    // Recombination
-    descendencyArray = m_population->recombineParents(parentsArray, m_generation);
+    // Recombination (sons are written on the descendency arena of the population)
+    population.recombineParents(generation);
 
     // Mutation
-    m_population->mutatePopulationDescendency(descendencyArray);    
+    population.mutatePopulationDescendency();    
+
+    // Evaluation
+    population.evaluatePopulationDescendency();
 
-    // Survival selection
-    m_population->selectSurvivals(descendencyArray);
+    // Local search on the best sons (if the population implements it)
+    population.improveDescendency(generation);
+
+    // Survival selection (swaps the descendency arena with the current population)
+    population.selectSurvivals();
 
     // Update of the ages of individuals
-    m_population->updateAgeOfPopulation(m_generation);
+    population.updateAgeOfPopulation(generation);
+
+}
+
+// Method that runs the island model
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+void GeneticAlgorithm<PopulationObject, IndividualClass, FileParametersObject>::
+runIslandModel()
+{
+    int nOfIslands = m_islands.size();
+
+    // Flag that stops all islands when one of them solves the sudoku, mutex that avoids mixing the
+    // logs of different islands and generation reached by each island
+    std::atomic<bool> solved(false);
+    std::mutex logMutex;
+    std::vector<int> generationReached(nOfIslands, 0);
+
+    // Runs each island on its own thread and waits until all of them have finished
+    std::vector<std::thread> islandThreads;
+    for(int island = 0; island < nOfIslands; island++)
+        islandThreads.emplace_back(&GeneticAlgorithm::runIsland, this, island, std::ref(solved),
+                                   std::ref(logMutex), std::ref(generationReached[island]));
+    for(std::thread& islandThread : islandThreads)
+        islandThread.join();
+
+    // Gets the island with the best individual (the sudoku is solved when the fitness value is 0)
+    int bestIsland = 0;
+    for(int island = 1; island < nOfIslands; island++)
+        if(m_islands[island]->getTheBestFitnessValue() < m_islands[bestIsland]->getTheBestFitnessValue())
+            bestIsland = island;
+
+    m_generation = generationReached[bestIsland];
+    m_solution = m_islands[bestIsland]->getTheBestIndividual();
+    m_solutionFind = m_solution.getFitnessValue() == 0;
+
+    // Prints the solution (or the best individual) on the screen
+    if(m_solutionFind)
+        std::cout << "SOLUTION FOUND by island " << bestIsland << " on generation " << m_generation << "\nSolution:\n";
+    else
+        std::cout << "NO SOLUTION FOUND\nBest individual (island " << bestIsland << "):\n";
+    printReachedSolution();
+}
+
+// Method that runs one island of the island model
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+void GeneticAlgorithm<PopulationObject, IndividualClass, FileParametersObject>::
+runIsland(int island, std::atomic<bool>& solved, std::mutex& logMutex, int& generationReached)
+{
+    PopulationObject& population = *m_islands[island];
+
+    // Buffers used on migrations
+    std::vector<int> migrantIndexes;
+    IndividualClass immigrant;
+
+    int generation = 0;
+    while(true)
+    {
+        // Runs one generation
+        generation++;
+        runOneGeneration(population, generation);
+
+        // Gets best and average fitness of the gen (the historical is the one of island 0)
+        const auto& statistics = population.getStatistics();
+        int bestFitnessValue = statistics.bestFitnessValue;
+        float avgFitnessValue = statistics.averageFitnessValue;
+        if(island == 0)
+        {
+            m_bestIndividualOfEachGen.push_back(bestFitnessValue);
+            m_avgIndividualOfEachGen.push_back(avgFitnessValue);
+        }
+
+        // Writes a log on stdout
+        if(generation % m_fileParameters.logEachXGenerations == 0)
+        {
+            std::lock_guard<std::mutex> lock(logMutex);
+            std::cout << "Island " << island << ": generation number " << generation << " finished.\n\tBest individuals fitness = "
+            << bestFitnessValue << "\n\tAverage fitness value = " << avgFitnessValue
+            << "\n\tFitness variance = " << statistics.fitnessVariance << std::endl << std::endl;
+        }
+
+        // Stops all islands if the sudoku has been solved, and this one if another one has solved it
+        if(bestFitnessValue == 0)
+            solved = true;
+        if(solved)
+            break;
+
+        // Stops if the max number of generations or seconds has been reached
+        if(generation >= m_fileParameters.maxGenerations && m_fileParameters.maxGenerations != 0)
+            break;
+        auto elapsedTime = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now()-m_ceroTime).count();
+        if(elapsedTime > m_fileParameters.maxSecondsOfExecution && m_fileParameters.maxSecondsOfExecution != 0)
+            break;
+
+        // Migrations (an interval lower than 1 is read as 1)
+        if(generation % std::max(1, m_fileParameters.migrationInterval) == 0)
+            migrate(island, migrantIndexes, immigrant);
+    }
+
+    generationReached = generation;
+}
 
+// Method that sends and receives the migrants of an island
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+void GeneticAlgorithm<PopulationObject, IndividualClass, FileParametersObject>::
+migrate(int island, std::vector<int>& migrantIndexes, IndividualClass& immigrant)
+{
+    PopulationObject& population = *m_islands[island];
+    int nOfIslands = m_islands.size();
+
+    // Sends copies of the best individuals to each neighbour (if its queue is full, they are lost)
+    population.getTheBestIndividualIndexes(m_fileParameters.numberOfMigrants, migrantIndexes);
+    for(int dst = 0; dst < nOfIslands; dst++)
+    {
+        if(!isMigrationRoute(island, dst))
+            continue;
+
+        for(int migrantIndex : migrantIndexes)
+            m_migrationQueues[dst * nOfIslands + island]->tryPush(population.getPopulation()[migrantIndex]);
+    }
+
+    // Each received migrant replaces the worst individual of the island
+    for(int src = 0; src < nOfIslands; src++)
+    {
+        if(!isMigrationRoute(src, island))
+            continue;
+
+        while(m_migrationQueues[island * nOfIslands + src]->tryPop(immigrant))
+            population.replaceTheWorstIndividual(immigrant);
+    }
+}
+
+// Method that checks whether island src sends migrants to island dst
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+bool GeneticAlgorithm<PopulationObject, IndividualClass, FileParametersObject>::
+isMigrationRoute(int src, int dst) const
+{
+    int nOfIslands = m_islands.size();
+    if(src == dst)
+        return false;
+
+    // 0: ring (each island sends migrants to the next one), 1: fully connected
+    if(m_fileParameters.migrationTopology == 0)
+        return dst == (src + 1) % nOfIslands;
+    return true;
 }
 
 // Method that checks the stop condition
@@ -260,8 +500,8 @@ getGeneration()
 
 // Method that returns the solution
 template <class PopulationObject, class IndividualClass, class FileParametersObject>
-IndividualClass GeneticAlgorithm<PopulationObject, IndividualClass, FileParametersObject>::
-getSolution()
+const IndividualClass& GeneticAlgorithm<PopulationObject, IndividualClass, FileParametersObject>::
+getSolution() const
 {
     return m_solution;
 }
@@ -273,8 +513,7 @@ printReachedSolution()
 {
     for(int i=1; i<=81; i++)
     {
-        auto genotype = m_solution.getGenotype();
-        std::cout << genotype[i-1].cellValue;
+        std::cout << m_solution.getCellValue(i-1);
         if(i % 9 == 0)
             std::cout << "\n";
         else
@@ -286,15 +525,15 @@ printReachedSolution()
 
 // Geters for m_bestIndividualOfEachGen and m_avgIndividualOfEachGen
 template <class PopulationObject, class IndividualClass, class FileParametersObject>
-std::vector<int> GeneticAlgorithm<PopulationObject, IndividualClass, FileParametersObject>::
-getBestIndividualsPerGenArray()
+const std::vector<int>& GeneticAlgorithm<PopulationObject, IndividualClass, FileParametersObject>::
+getBestIndividualsPerGenArray() const
 {
     return m_bestIndividualOfEachGen;
 }
 
 template <class PopulationObject, class IndividualClass, class FileParametersObject>
-std::vector<float> GeneticAlgorithm<PopulationObject, IndividualClass, FileParametersObject>::
-getAvgIndividualsPerGenArray()
+const std::vector<float>& GeneticAlgorithm<PopulationObject, IndividualClass, FileParametersObject>::
+getAvgIndividualsPerGenArray() const
 {
     return m_avgIndividualOfEachGen;
 }
\ No newline at end of file
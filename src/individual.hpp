@@ -1,8 +1,11 @@
 #pragma once // Multiple inclusion guardian
 
 #include <vector> // std::vector
+#include <utility> // std::move
 #include <iostream> //borrar
 
+#include "randomNumberGenerator.hpp" // RandomNumberGenerator
+
 /*
 
 Individual class:
@@ -11,23 +14,29 @@ A class template that represents a generic individual. As it is an abstract clas
 that inherits from this one must be created in order to represent the individual of a certain
 optimization task. Therefore, the following virtual functions must be defined:
 
-    virtual void initializeIndividual() = 0;
+    virtual void initializeIndividual(RandomNumberGenerator& rng) = 0;
 
     virtual void calculateFitnessValue() = 0;
 
-    virtual void mutateIndividual(float pm) = 0;
+    virtual void mutateIndividual(float pm, RandomNumberGenerator& rng) = 0;
+
+Random values are taken from the generator they receive (randomNumberGenerator.hpp), so that each
+individual can be initialized and mutated with its own generator on any thread.
 
 As both the representation type and the fitness value type may be different depending on the task,
 they have been declared ad templates, with the following names:
 
-    template <class RepresentationType, class FitnessValueType>
+    template <class RepresentationType, class FitnessValueType, class GenotypeContainer>
 
-Where RepresentationType is the data type of which the genotype is going to be composed of and
-FitnessValueType is the data type of the fitness function value (int or float most times)
+Where RepresentationType is the data type of which the genotype is going to be composed of,
+FitnessValueType is the data type of the fitness function value (int or float most times) and
+GenotypeContainer is the container that holds the genotype (std::vector<RepresentationType> by
+default, a fixed size container such as std::array can be used when the length of the genotype is
+known at compile time so that individuals are copied without allocating memory)
 
 */
 
-template <class RepresentationType, class FitnessValueType>
+template <class RepresentationType, class FitnessValueType, class GenotypeContainer = std::vector<RepresentationType>>
 class Individual
 {
 
@@ -41,7 +50,7 @@ protected:
     unsigned int m_lengthOfTheGenotype;
     
     // A chain of a certain data type that represents the genotype of the individual
-    std::vector<RepresentationType> m_genotype;
+    GenotypeContainer m_genotype;
 
     // A value (normally int or float/double) that represents the fitness value of the individual
     FitnessValueType m_fitnessValue;
@@ -60,11 +69,13 @@ public:
     // Any individual of any kind in a genetic algorithm will have at least the following methods:
 
     // A initializer for the genotype (random or informed)
-    virtual void initializeIndividual() = 0;
+    virtual void initializeIndividual(RandomNumberGenerator& rng) = 0;
     // A fitness value (provided a fitness function)
     virtual void calculateFitnessValue() = 0;
     // A mutation method
-    virtual void mutateIndividual(float pm) = 0;
+    virtual void mutateIndividual(float pm, RandomNumberGenerator& rng) = 0;
+
+    // Random methods receive the generator (stream) they must use
 
     // As their nature will depend on representation, fitness function etc., they have
     // been created as pure virtual methods, and they will be defined o a class that
@@ -76,7 +87,7 @@ public:
     Individual(int creationGen, unsigned int lengthOfTheGenotype);
 
     // Genotype of post-initial populations will get their genotype from recombination
-    Individual(int creationGen, unsigned int lengthOfTheGenotype, std::vector<RepresentationType> genotype);
+    Individual(int creationGen, unsigned int lengthOfTheGenotype, GenotypeContainer genotype);
 
     // Standard constructor
     Individual(){}
@@ -91,12 +102,14 @@ public:
     unsigned int getLengthOfTheGenotype();
     void setLengthOfTheGenotype(unsigned int lengthOfTheGenotype);
 
-    // Setter and getter for genotype
-    void updateGenotype(std::vector<RepresentationType> genotype);
-    std::vector<RepresentationType> getGenotype();
+    // Setters (copying or moving) and getter for genotype. The getter returns a reference so
+    // that the genotype is not copied
+    void updateGenotype(const GenotypeContainer& genotype);
+    void updateGenotype(GenotypeContainer&& genotype);
+    const GenotypeContainer& getGenotype() const;
 
     // Getter for fitnessValue (not a setter because it must not be changed unless it is changed by calculateFitnessValue())
-    FitnessValueType getFitnessValue();
+    FitnessValueType getFitnessValue() const;
 
     // setter for creation gen
     void setCreationGen(int creationGen);
@@ -111,76 +124,83 @@ public:
 
 // CONSTRUCTORS //
 
-template <class RepresentationType, class FitnessValueType>
-Individual<RepresentationType, FitnessValueType>::
+template <class RepresentationType, class FitnessValueType, class GenotypeContainer>
+Individual<RepresentationType, FitnessValueType, GenotypeContainer>::
 Individual(int creationGen, unsigned int lengthOfTheGenotype):
-m_creationGen(creationGen), m_lengthOfTheGenotype(lengthOfTheGenotype)
+m_lengthOfTheGenotype(lengthOfTheGenotype), m_creationGen(creationGen)
 {
 
 }
 
-template <class RepresentationType, class FitnessValueType>
-Individual<RepresentationType, FitnessValueType>::
-Individual(int creationGen, unsigned int lengthOfTheGenotype, std::vector<RepresentationType> genotype):
-m_creationGen(creationGen), m_lengthOfTheGenotype(lengthOfTheGenotype)
+template <class RepresentationType, class FitnessValueType, class GenotypeContainer>
+Individual<RepresentationType, FitnessValueType, GenotypeContainer>::
+Individual(int creationGen, unsigned int lengthOfTheGenotype, GenotypeContainer genotype):
+m_lengthOfTheGenotype(lengthOfTheGenotype), m_creationGen(creationGen)
 {
-    m_genotype = genotype;
+    m_genotype = std::move(genotype);
 }
 
 
 // SETERS, GETTERS AND UPDATERS //
 
 // Getter for m_lengthOfTheGenotype
-template <class RepresentationType, class FitnessValueType>
-unsigned int Individual<RepresentationType, FitnessValueType>::
+template <class RepresentationType, class FitnessValueType, class GenotypeContainer>
+unsigned int Individual<RepresentationType, FitnessValueType, GenotypeContainer>::
 getLengthOfTheGenotype()
 {
     return m_lengthOfTheGenotype;
 }
 
 // Setter for m_lengthOfTheGenotype 
-template <class RepresentationType, class FitnessValueType>
-void Individual<RepresentationType, FitnessValueType>::
+template <class RepresentationType, class FitnessValueType, class GenotypeContainer>
+void Individual<RepresentationType, FitnessValueType, GenotypeContainer>::
 setLengthOfTheGenotype(unsigned int lengthOfTheGenotype)
 {
     m_lengthOfTheGenotype = lengthOfTheGenotype;
 }
 
-// Updater for m_genotype
-template <class RepresentationType, class FitnessValueType>
-void Individual<RepresentationType, FitnessValueType>::
-updateGenotype(std::vector<RepresentationType> genotype)
+// Updaters for m_genotype
+template <class RepresentationType, class FitnessValueType, class GenotypeContainer>
+void Individual<RepresentationType, FitnessValueType, GenotypeContainer>::
+updateGenotype(const GenotypeContainer& genotype)
 {
     m_genotype = genotype;
 }
 
+template <class RepresentationType, class FitnessValueType, class GenotypeContainer>
+void Individual<RepresentationType, FitnessValueType, GenotypeContainer>::
+updateGenotype(GenotypeContainer&& genotype)
+{
+    m_genotype = std::move(genotype);
+}
+
 // Getter for m_genotype
-template <class RepresentationType, class FitnessValueType>
-std::vector<RepresentationType> Individual<RepresentationType, FitnessValueType>::
-getGenotype()
+template <class RepresentationType, class FitnessValueType, class GenotypeContainer>
+const GenotypeContainer& Individual<RepresentationType, FitnessValueType, GenotypeContainer>::
+getGenotype() const
 {
     return m_genotype;
 }
 
 // Getter for m_fitnessValue
-template <class RepresentationType, class FitnessValueType>
-FitnessValueType Individual<RepresentationType, FitnessValueType>::
-getFitnessValue()
+template <class RepresentationType, class FitnessValueType, class GenotypeContainer>
+FitnessValueType Individual<RepresentationType, FitnessValueType, GenotypeContainer>::
+getFitnessValue() const
 {
     return m_fitnessValue;
 }
 
 // Setter for creation gen
-template <class RepresentationType, class FitnessValueType>
-void Individual<RepresentationType, FitnessValueType>::
+template <class RepresentationType, class FitnessValueType, class GenotypeContainer>
+void Individual<RepresentationType, FitnessValueType, GenotypeContainer>::
 setCreationGen(int creationGen)
 {
     m_creationGen = creationGen;
 }
 
 // Updater for m_age
-template <class RepresentationType, class FitnessValueType>
-void Individual<RepresentationType, FitnessValueType>::
+template <class RepresentationType, class FitnessValueType, class GenotypeContainer>
+void Individual<RepresentationType, FitnessValueType, GenotypeContainer>::
 updateAgeOfIndividual(unsigned int currentGen)
 {
     // The age of a individual is the diference between the current gen and the gen in which it was created
@@ -189,8 +209,8 @@ updateAgeOfIndividual(unsigned int currentGen)
 }
 
 // Getter for m_age
-template <class RepresentationType, class FitnessValueType>
-unsigned int Individual<RepresentationType, FitnessValueType>::
+template <class RepresentationType, class FitnessValueType, class GenotypeContainer>
+unsigned int Individual<RepresentationType, FitnessValueType, GenotypeContainer>::
 getIndividualAge()
 {
     return m_age;
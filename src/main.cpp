@@ -1,7 +1,8 @@
 #include <iostream> // std::cout, std::endl
-#include <random> // std::seed_seq, std::mt19937
 #include <fstream> // std::ofstream
-#include <algorithm> // std::accumulate, std::distance
+#include <algorithm> // std::distance
+#include <numeric> // std::accumulate
+#include <chrono> // time measures
 
 // Some functions are for debugging purposes,so only are defined and called if
 // the line below is not commented
@@ -9,26 +10,30 @@
 
 #include "sudokuProblemPopulation.hpp" // SDK_Population
 #include "sudokuProblemIndividual.hpp" // SDK_Individual
+#include "sudokuRowPermutationIndividual.hpp" // SDK_RowPermutationIndividual
 #include "sudokuReader.hpp" // SudokuReader
-#include "sudokuCell.hpp" // SudokuCell
 #include "geneticAlgorithm.hpp" // GeneticAlgorithm
 #include "fileParameters.hpp" // FileParameters
 #include "fileParametersReader.hpp" // FileParametersReader
+#include "corpusSolver.hpp" // CorpusSolver
+#include "streamSolver.hpp" // StreamSolver
+#include "batchFitnessEvaluation.hpp" // get_batch_fitness_instruction_set
 
 // Defines the types of the representation of each gen and the data type of the fitness function
-#define GENOME_REPRESENTATION_TYPE SudokuCell
+#define GENOME_REPRESENTATION_TYPE uint8_t
 #define FITNESS_VALUE_DATA_TYPE int
 
 // Defines individual and population types with their template values
 #define INDIVIDUAL_TYPE SDK_Individual<GENOME_REPRESENTATION_TYPE, FITNESS_VALUE_DATA_TYPE>
 #define POPULATION_TYPE SDK_Population<GENOME_REPRESENTATION_TYPE, FITNESS_VALUE_DATA_TYPE, INDIVIDUAL_TYPE>
 
+// The same types with individuals whose rows are permutations (individualRepresentation = 1)
+#define ROW_PERMUTATION_INDIVIDUAL_TYPE SDK_RowPermutationIndividual<GENOME_REPRESENTATION_TYPE, FITNESS_VALUE_DATA_TYPE>
+#define ROW_PERMUTATION_POPULATION_TYPE SDK_Population<GENOME_REPRESENTATION_TYPE, FITNESS_VALUE_DATA_TYPE, ROW_PERMUTATION_INDIVIDUAL_TYPE>
+
 // Function that prints the parameters read from the file on stdout
 void printFileParameters(FileParameters f);
 
-// Function that sets the random seed
-void setRandomSeed(int seed);
-
 // Function used to get the initial progress curve so that the max number of generations is logically set
 void getInitialProgressCurves(FileParameters fileParameters, std::vector<int> sudoku_cells);
 
@@ -40,8 +45,21 @@ void generateParametersForEvaluation(FileParameters fileParameters, std::vector<
 
 void generateLogFileWithParameters(std::vector<int> bestIndividuals, std::vector<float> avgIndividuals, int generationReached, std::string name);
 
-// RandomGenerator object defined on utils.cpp
-std::mt19937 RandomGenerator;
+// Solves the sudoku of sudokuFilePath (or the sudokus of the corpus or the stream) with the given types
+// of population and individual
+template <class PopulationObject, class IndividualClass>
+int solveSudokus(FileParameters fileParameters);
+
+// Solves all sudokus of the corpus file
+template <class PopulationObject, class IndividualClass>
+int solveCorpus(FileParameters fileParameters);
+
+// Solves the sudokus of the stream while they are read
+template <class PopulationObject, class IndividualClass>
+int solveStream(FileParameters fileParameters);
+
+// Converts the corpus file into a binary corpus
+int convertCorpusToBinary(FileParameters fileParameters);
 
 int main()
 {
@@ -52,14 +70,39 @@ int main()
     FileParametersReader fileParametersReader("./data/parameters/genetic_algorithm_configuration.txt");
     fileParameters = fileParametersReader.getFileParameters();
 
-    // Sets the random seed with the read value
-    setRandomSeed(fileParameters.randomSeed);
-
     #if defined DEBUG_MODE_ON
         // Prints the read FileParameters object (debugging)
         printFileParameters(fileParameters);
     #endif
 
+    // Writes the instruction set selected at runtime for batch fitness evaluation (on stderr, as
+    // stdout may be the results of the stream mode)
+    if(fileParameters.batchFitnessEvaluation)
+        std::cerr << "Batch fitness evaluation with " << get_batch_fitness_instruction_set() << " instructions" << std::endl;
+
+    // If a binary corpus has been provided, the corpus is converted into it
+    if(!fileParameters.corpusFilePath.empty() && !fileParameters.binaryCorpusFilePath.empty())
+        return convertCorpusToBinary(fileParameters);
+
+    // Solves the sudokus with the representation of the individuals read from the file
+    if(fileParameters.individualRepresentation == 1)
+        return solveSudokus<ROW_PERMUTATION_POPULATION_TYPE, ROW_PERMUTATION_INDIVIDUAL_TYPE>(fileParameters);
+
+    return solveSudokus<POPULATION_TYPE, INDIVIDUAL_TYPE>(fileParameters);
+}
+
+// Function that solves the sudoku of sudokuFilePath (or the sudokus of the corpus or the stream)
+template <class PopulationObject, class IndividualClass>
+int solveSudokus(FileParameters fileParameters)
+{
+    // If a stream has been provided, its sudokus are solved while they are read
+    if(!fileParameters.streamInputFilePath.empty())
+        return solveStream<PopulationObject, IndividualClass>(fileParameters);
+
+    // If a corpus has been provided, all its sudokus are solved instead of the one of sudokuFilePath
+    if(!fileParameters.corpusFilePath.empty())
+        return solveCorpus<PopulationObject, IndividualClass>(fileParameters);
+
     // Reads the sudoku to be solved and creates the corresponding vector of ints
     //SudokuReader sudokuReader("./data/sudokus/easy_sudoku.txt");
     SudokuReader sudokuReader(fileParameters.sudokuFilePath);
@@ -70,7 +113,7 @@ int main()
         return -1;
 
     // Initializes the genetic algorithm
-    GeneticAlgorithm<POPULATION_TYPE, INDIVIDUAL_TYPE, FileParameters> GeneticAlgorithm(fileParameters, sudoku_cells);
+    GeneticAlgorithm<PopulationObject, IndividualClass, FileParameters> GeneticAlgorithm(fileParameters, sudoku_cells);
 
     // Initialized the population
     GeneticAlgorithm.initializePopulation();
@@ -81,6 +124,88 @@ int main()
     return 0;
 }
 
+// Function that solves all sudokus of the corpus file and writes their results
+template <class PopulationObject, class IndividualClass>
+int solveCorpus(FileParameters fileParameters)
+{
+    CorpusSolver<PopulationObject, IndividualClass, FileParameters> corpusSolver(fileParameters);
+    if(!corpusSolver.readCorpus(fileParameters.corpusFilePath))
+        return -1;
+
+    // Solves all of them measuring the time
+    auto ceroTime = std::chrono::steady_clock::now();
+    corpusSolver.solveCorpus();
+    auto elapsedMilliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now()-ceroTime).count();
+
+    corpusSolver.writeResults(fileParameters.corpusResultsFilePath);
+
+    // Writes a summary on stdout
+    const std::vector<CorpusPuzzleResult>& results = corpusSolver.getResults();
+    int nOfSolvedPuzzles = 0;
+    for(const CorpusPuzzleResult& result : results)
+        nOfSolvedPuzzles += result.solved;
+
+    std::cout << "Corpus finished. " << nOfSolvedPuzzles << " of " << results.size() << " sudokus solved in "
+              << elapsedMilliseconds << " ms. Results written on " << fileParameters.corpusResultsFilePath << std::endl;
+
+    return 0;
+}
+
+// Function that converts the corpus file into a binary corpus
+int convertCorpusToBinary(FileParameters fileParameters)
+{
+    long nOfPuzzles = convert_text_corpus_to_binary(fileParameters.corpusFilePath, fileParameters.binaryCorpusFilePath);
+    if(nOfPuzzles < 0)
+        return -1;
+
+    std::cout << nOfPuzzles << " sudokus written on the binary corpus " << fileParameters.binaryCorpusFilePath << std::endl;
+    return 0;
+}
+
+// Function that solves the sudokus of the stream while they are read, writing each result as soon as
+// it is solved. stdout may be the results stream, so the summary is written on stderr
+template <class PopulationObject, class IndividualClass>
+int solveStream(FileParameters fileParameters)
+{
+    // Nothing else is written with the C streams, so the C++ ones do not need to be synchronized with them
+    std::ios::sync_with_stdio(false);
+
+    // Opens the input and results streams ("-" means stdin and stdout)
+    std::ifstream inputFile;
+    if(fileParameters.streamInputFilePath != "-")
+    {
+        inputFile.open(fileParameters.streamInputFilePath);
+        if(!inputFile.is_open())
+        {
+            std::cerr << "Cannot open stream input file in:\n" << fileParameters.streamInputFilePath << std::endl;
+            return -1;
+        }
+    }
+    std::ofstream resultsFile;
+    if(fileParameters.streamResultsFilePath != "-")
+    {
+        resultsFile.open(fileParameters.streamResultsFilePath);
+        if(!resultsFile.is_open())
+        {
+            std::cerr << "Cannot open stream results file in:\n" << fileParameters.streamResultsFilePath << std::endl;
+            return -1;
+        }
+    }
+    std::istream& inputStream = inputFile.is_open() ? static_cast<std::istream&>(inputFile) : std::cin;
+    std::ostream& resultsStream = resultsFile.is_open() ? static_cast<std::ostream&>(resultsFile) : std::cout;
+
+    // Solves all of them measuring the time
+    StreamSolver<PopulationObject, IndividualClass, FileParameters> streamSolver(fileParameters);
+    auto ceroTime = std::chrono::steady_clock::now();
+    streamSolver.solveStream(inputStream, resultsStream);
+    auto elapsedMilliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now()-ceroTime).count();
+
+    std::cerr << "Stream finished. " << streamSolver.getNumberOfSolvedPuzzles() << " of " << streamSolver.getNumberOfPuzzles()
+              << " sudokus solved in " << elapsedMilliseconds << " ms" << std::endl;
+
+    return 0;
+}
+
 // Function that prints the parameters read from the file on stdout
 void printFileParameters(FileParameters f)
 {
@@ -91,27 +216,45 @@ void printFileParameters(FileParameters f)
     std::cout << "populationLength = " << f.populationLength << std::endl;
     std::cout << "maxGenerations = " << f.maxGenerations << std::endl;
     std::cout << "maximizationProblem = " << f.maximizationProblem << std::endl;
+    std::cout << "batchFitnessEvaluation = " << f.batchFitnessEvaluation << std::endl;
+    std::cout << "fitnessCacheSize = " << f.fitnessCacheSize << std::endl;
+    std::cout << "numberOfThreads = " << f.numberOfThreads << std::endl;
+    std::cout << "constraintPropagation = " << f.constraintPropagation << std::endl;
+    std::cout << "corpusFilePath = " << f.corpusFilePath << std::endl;
+    std::cout << "corpusResultsFilePath = " << f.corpusResultsFilePath << std::endl;
+    std::cout << "numberOfCorpusWorkers = " << f.numberOfCorpusWorkers << std::endl;
+    std::cout << "binaryCorpusFilePath = " << f.binaryCorpusFilePath << std::endl;
+    std::cout << "streamInputFilePath = " << f.streamInputFilePath << std::endl;
+    std::cout << "streamResultsFilePath = " << f.streamResultsFilePath << std::endl;
+    std::cout << "streamQueueCapacity = " << f.streamQueueCapacity << std::endl;
+    std::cout << "numberOfIslands = " << f.numberOfIslands << std::endl;
+    std::cout << "migrationInterval = " << f.migrationInterval << std::endl;
+    std::cout << "numberOfMigrants = " << f.numberOfMigrants << std::endl;
+    std::cout << "migrationTopology = " << f.migrationTopology << std::endl;
     std::cout << "parentSelectionMethod = " << f.parentSelectionMethod << std::endl;
     std::cout << "lambda_nOfParentsSelected = " << f.lambda_nOfParentsSelected << std::endl;
     std::cout << "gamma_tournamentSelection = " << f.gamma_tournamentSelection << std::endl;
     std::cout << "p_bestParentSelectedProb = " << f.p_bestParentSelectedProb << std::endl;
     std::cout << "excludingTournament = " << f.excludingTournament << std::endl;
+    std::cout << "rankSelectionPressure = " << f.rankSelectionPressure << std::endl;
+    std::cout << "truncationProportion = " << f.truncationProportion << std::endl;
+    std::cout << "pc_crossoverProb = " << f.pc_crossoverProb << std::endl;
+    std::cout << "crossoverMethod = " << f.crossoverMethod << std::endl;
     std::cout << "pm_mutationProb = " << f.pm_mutationProb << std::endl;
     std::cout << "mutation_method = " << f.mutation_method << std::endl;
+    std::cout << "individualRepresentation = " << f.individualRepresentation << std::endl;
+    std::cout << "localSearchIndividuals = " << f.localSearchIndividuals << std::endl;
+    std::cout << "localSearchSteps = " << f.localSearchSteps << std::endl;
+    std::cout << "localSearchTabuTenure = " << f.localSearchTabuTenure << std::endl;
     std::cout << "generationalModel = " << f.generationalModel << std::endl;
+    std::cout << "steadyStateReplacement = " << f.steadyStateReplacement << std::endl;
+    std::cout << "survivalStrategy = " << f.survivalStrategy << std::endl;
     std::cout << "elitism = " << f.elitism << std::endl;
+    std::cout << "numberOfElites = " << f.numberOfElites << std::endl;
 
     std::cout << std::endl;
 }
 
-// Function that sets the random seed
-void setRandomSeed(int seed)
-{
-    std::seed_seq seq{seed, seed+100, seed+200};
-    std::mt19937 rng(seq);
-    RandomGenerator = rng;
-}
-
 /// ALL FUNCTIONS BELOW ARE USED TO GENERATE THE CORRESPONDING LOG FILES ///
 
 // Function used to get the initial progress curve so that the max number of generations is logically set
@@ -127,7 +270,6 @@ void getInitialProgressCurves(FileParameters fileParameters, std::vector<int> su
     while(it != randomSeeds.end())
     {
         fileParameters.randomSeed = *it;
-        setRandomSeed(fileParameters.randomSeed);
 
         // Initializes the genetic algorithm
         GeneticAlgorithm<POPULATION_TYPE, INDIVIDUAL_TYPE, FileParameters> GeneticAlgorithm(fileParameters, sudoku_cells);
@@ -139,8 +281,8 @@ void getInitialProgressCurves(FileParameters fileParameters, std::vector<int> su
         GeneticAlgorithm.runGeneticAlgorithm();
 
         // Get fitness value vectors
-        std::vector<int> bestFitnesses = GeneticAlgorithm.getBestIndividualsPerGenArray();
-        std::vector<float> avgFitnesses = GeneticAlgorithm.getAvgIndividualsPerGenArray();
+        const std::vector<int>& bestFitnesses = GeneticAlgorithm.getBestIndividualsPerGenArray();
+        const std::vector<float>& avgFitnesses = GeneticAlgorithm.getAvgIndividualsPerGenArray();
 
         std::string filename = std::to_string(i) + ".txt";
         generateProgressCurveFile(bestFitnesses, avgFitnesses, filename);
@@ -159,7 +301,7 @@ void generateProgressCurveFile(std::vector<int> bestIndividuals, std::vector<flo
     file.open ("./data/curves/easy_sudoku/first_progress_curves/" + name);
 
     // Write each line: generation,bestFitness,avgFitness
-    for(int i=0; i < bestIndividuals.size(); i++)
+    for(unsigned int i=0; i < bestIndividuals.size(); i++)
     {
         file << i+1 << "," << bestIndividuals[i] << "," << avgIndividuals[i] << "\n";
     }
@@ -186,10 +328,9 @@ void generateParametersForEvaluation(FileParameters fileParameters, std::vector<
     std::vector<int> arrayOf_ElapsedGens;
 
     // For each different seed
-    for(int i=0; i<seeds.size(); i++)
+    for(unsigned int i=0; i<seeds.size(); i++)
     {
         fileParameters.randomSeed = seeds[i];
-        setRandomSeed(fileParameters.randomSeed);
 
         // Initializes the genetic algorithm
         GeneticAlgorithm<POPULATION_TYPE, INDIVIDUAL_TYPE, FileParameters> GeneticAlgorithm(fileParameters, sudoku_cells);
@@ -201,8 +342,8 @@ void generateParametersForEvaluation(FileParameters fileParameters, std::vector<
         GeneticAlgorithm.runGeneticAlgorithm();
 
         // Get fitness value vectors
-        std::vector<int> bestFitnesses = GeneticAlgorithm.getBestIndividualsPerGenArray();
-        std::vector<float> avgFitnesses = GeneticAlgorithm.getAvgIndividualsPerGenArray();
+        const std::vector<int>& bestFitnesses = GeneticAlgorithm.getBestIndividualsPerGenArray();
+        const std::vector<float>& avgFitnesses = GeneticAlgorithm.getAvgIndividualsPerGenArray();
 
         // If it has found the solution increase the counter
         if(GeneticAlgorithm.checkSolution())
@@ -1,14 +1,20 @@
 #pragma once // Multiple inclusion guardian
 
 #include <vector> // std::vector
-#include <set> // std::set
-#include <algorithm> // std::min_element, std::max_element and std::accumulate
-#include <iterator> // std::vector<T>::iterator and std::set<T>::iterator
+#include <algorithm> // std::min, std::max, std::swap
+#include <iterator> // std::vector<T>::iterator
+#include <memory> // std::unique_ptr
+#include <cstdint> // uint64_t
 
-#include "utils.hpp" // Random distributions
+#include "utils.hpp" // Random functions
+#include "cacheAlignedAllocator.hpp" // CacheAlignedAllocator
+#include "threadPool.hpp" // ThreadPool
+#include "populationStatistics.hpp" // PopulationStatistics
+#include "fitnessBucketIndex.hpp" // FitnessBucketIndex
 
-// To refer to an array of individuals (std::vector<IndividualClass>) more intuitively
-#define arrayOfIndividuals std::vector<IndividualClass>
+// To refer to an array of individuals (std::vector<IndividualClass>, allocated at the beginning of a
+// cache line) more intuitively
+#define arrayOfIndividuals std::vector<IndividualClass, CacheAlignedAllocator<IndividualClass>>
 
 /* 
 
@@ -18,16 +24,33 @@ A class template that represents a population of a genetic algorithm.  As it is
 that inherits from this one must be created in order to represent the population of a certain
 optimization task. Therefore, the following virtual functions must be defined:
 
-    virtual arrayOfIndividuals recombineParents(arrayOfIndividuals parents) = 0;
+    virtual void recombineParents(int generation) = 0;
 
-    virtual void selectSurvivals(arrayOfIndividuals currentPopulationDescendency) = 0;
+    virtual void evaluatePopulationDescendency() = 0;
 
-Those functions represent the recombination and survival selection steps respectively, as they will
-be different on each optimization task. Conversely, as parent selection is always the same (only depends on
+    virtual void selectSurvivals() = 0;
+
+Those functions represent the recombination, evaluation and survival selection steps respectively, as
+they will be different on each optimization task. Conversely, as parent selection is always the same (only depends on
 the fitness value of each individual + some other generic parameters like age of each individual and elitism), it
 is defined here so that it can be always used in any generic algorithm that uses this class template without
 having to redefine it again.
 
+The population lives in two arenas of individuals that are allocated only once: the current population
+(m_populationArray) and the next one (m_descendencyArray). On each generation:
+
+    - parent selection stores the indexes of the selected parents on m_parentIndexes
+    - recombination writes the sons directly on m_descendencyArray (overwriting the individuals of two
+      generations ago, so no memory is allocated)
+    - mutation and evaluation are applied to m_descendencyArray
+    - survival selection swaps both arenas
+
+Recombination, mutation and evaluation of each pair of sons are independent from the rest of pairs, so
+they are run in parallel by m_threadPool. Each pair uses its own random number generator, whose stream is
+derived from the random seed, the generation and the pair (seedPairRandomGenerators()), so the result of a
+given random seed is the same regardless of the number of threads.
+
+
 Template types of this class are the following:
 
     template <class RepresentationType, class FitnessValueType, class IndividualClass>
@@ -52,6 +75,18 @@ protected:
     // Array of individuals that contain the current population
     arrayOfIndividuals m_populationArray;
 
+    // Array of individuals where the descendency of the current population is written. It becomes
+    // the current population on survival selection
+    arrayOfIndividuals m_descendencyArray;
+
+    // Indexes (on m_populationArray) of the parents selected on the current generation
+    std::vector<int> m_parentIndexes;
+
+    // Fitness values of the current population and pool of indexes of the individuals that can be
+    // chosen, both used on tournament selection
+    std::vector<FitnessValueType> m_tournamentFitnessValues;
+    std::vector<int> m_selectableParents;
+
     // Current lenght of the population
     unsigned int m_populationLength;
 
@@ -70,9 +105,22 @@ protected:
     // Whether the tournament selection is excluding or not
     bool m_excludingTournament;
 
-    // Parent selection method: 0->tournament selection
+    // Parent selection method: 0->tournament selection, 1->linear rank selection, 2->fitness
+    // proportional selection (stochastic universal sampling), 3->truncation selection
     int m_parentSelectionMethod;
 
+    // Selection pressure of linear rank selection (expected number of times the best individual is
+    // selected as parent when lambda is the length of the population, between 1 and 2)
+    float m_rankSelectionPressure;
+
+    // Proportion of the best individuals of the population that can be selected on truncation
+    // selection
+    float m_truncationProportion;
+
+    // Cumulative selection weights of each rank (linear rank selection) or of each individual
+    // (fitness proportional selection), used on stochastic universal sampling
+    std::vector<double> m_cumulativeSelectionWeights;
+
     // Number of parents selected on each recombination step
     int m_lambda_nOfParentsSelected;
 
@@ -88,63 +136,165 @@ protected:
     // Fitness value of the best individual of the last population
     FitnessValueType m_lastBestFitnessValue;
 
+    // Random number generator used by the sequential steps of the population (seeded from the random
+    // seed of the configuration file)
+    RandomNumberGenerator m_randomGenerator;
+
+    // Random seed of the configuration file and random number generators of each pair of sons of the
+    // current generation (see seedPairRandomGenerators())
+    int m_randomSeed;
+    std::vector<RandomNumberGenerator> m_pairRandomGenerators;
+
+    // Threads that run the steps that are done in parallel for each pair of sons
+    std::unique_ptr<ThreadPool> m_threadPool;
+
+    // Statistics of the current population and whether they must be calculated again (see
+    // getStatistics()). Every method that changes m_populationArray must call invalidateStatistics()
+    mutable PopulationStatistics<FitnessValueType> m_statistics;
+    mutable bool m_outdatedStatistics = true;
+
+    // Individuals of the current population ordered by fitness value and whether it must be built
+    // again (see getBucketIndex()). It is outdated at the same time as the statistics, except when a
+    // single individual is replaced (see replaceIndividual()), as it is then updated
+    mutable FitnessBucketIndex<FitnessValueType> m_bucketIndex;
+    mutable bool m_outdatedBucketIndex = true;
+
 public:
 
     // PURE VIRTUAL FUNCTIONS //
 
-    // Recombination step
-    virtual arrayOfIndividuals recombineParents(arrayOfIndividuals parents, int generation) = 0;
+    // Recombination step (the parents of m_parentIndexes are recombined and the sons are written on
+    // m_descendencyArray)
+    virtual void recombineParents(int generation) = 0;
+
+    // Evaluation step (fitness values of m_descendencyArray that have not been calculated during
+    // recombination and mutation)
+    virtual void evaluatePopulationDescendency() = 0;
+
+    // Survival selection step (builds the next population on m_descendencyArray and swaps it with
+    // m_populationArray, or replaces some individuals of m_populationArray in place)
+    virtual void selectSurvivals() = 0;
 
-    // Survival selection step
-    virtual void selectSurvivals(arrayOfIndividuals currentPopulationDescendency) = 0;
+    // OPTIONAL STEPS //
+
+    // Local search step (improves some individuals of m_descendencyArray after their evaluation). It
+    // does nothing by default, so the generation (used by populations that implement it to seed
+    // their random number generators) is not used
+    virtual void improveDescendency(int /*generation*/) {}
 
     // CONSTRUCTOR AND DESTRUCTOR //
 
-    // Standard onstructor and destructor
-    Population() {}
+    // Standard onstructor (without threads) and destructor
+    Population(): m_threadPool(new ThreadPool(1)) {}
     ~Population() {}
 
-    // Parent selection step
-    arrayOfIndividuals selectParentsFromPopulation();
+    // Parent selection step (the indexes of the parents are stored on m_parentIndexes)
+    void selectParentsFromPopulation();
 
     // Mutation step
-    void mutatePopulationDescendency(arrayOfIndividuals& descendency);
+    void mutatePopulationDescendency();
+
+    // Seeds the random number generator of each pair of sons of the current generation
+    void seedPairRandomGenerators(int generation);
 
-    // Best individual and it's fitness value
-    FitnessValueType getTheBestFitnessValue();
-    IndividualClass getTheBestIndividual();
+    // Number of pairs of parents selected on the current generation, which is also the number of
+    // pairs of sons (lambda is always even, so every parent has a partner)
+    int getNumberOfPairs() const;
+
+    // Getter for the length of the genotype of the individuals (0 if all cells are fixed)
+    int getLengthOfTheGenotype() const;
+
+    // Best individual, its position on the population and its fitness value
+    FitnessValueType getTheBestFitnessValue() const;
+    const IndividualClass& getTheBestIndividual() const;
+    int getTheBestIndividualIndex() const;
+
+    // Positions of the k best individuals of the population (from best to worst) and position of
+    // the worst one
+    void getTheBestIndividualIndexes(int k, std::vector<int>& indexes) const;
+    int getTheWorstIndividualIndex() const;
+
+    // Replaces the worst individual of the population with another one (used on migrations)
+    void replaceTheWorstIndividual(const IndividualClass& individual);
+
+    // Replaces an individual of the population in place with another one. The bucket index, if it is
+    // up to date, is updated instead of being built again
+    void replaceIndividual(int index, const IndividualClass& individual);
 
     // Average fitness value of the population
-    float getAverageFitnessValue();
+    float getAverageFitnessValue() const;
+
+    // Statistics of the fitness values of the population (calculated on a single pass the first
+    // time they are needed after the population has changed)
+    const PopulationStatistics<FitnessValueType>& getStatistics() const;
+
+    // Individuals of the population ordered by fitness value (built on O(N + F) the first time it is
+    // needed after the population has changed, and updated when a single individual is replaced, see
+    // fitnessBucketIndex.hpp). Only for integer fitness values
+    const FitnessBucketIndex<FitnessValueType>& getBucketIndex() const;
+
+    // Position of the individual of a rank (0 is the best one) on the population
+    int getIndividualIndexOfRank(int rank) const;
+
+    // Marks the statistics and the bucket index as outdated (each time the population changes)
+    void invalidateStatistics();
 
     // Different parent selection method
-    arrayOfIndividuals tournamentSelection();
+    void tournamentSelection();
+
+    // Method used in tournament selection fot getting the index of an individual
+    int getIndividualFromTournament(int& nOfSelectableParents);
 
-    // Method used in tournament selection fot getting individuals
-    IndividualClass getIndividualFromTournament(std::set<int>& selectableParents);
+    // Linear rank selection, fitness proportional selection and truncation selection, all of them on
+    // O(N + lambda)
+    void linearRankSelection();
+    void fitnessProportionalSelection();
+    void truncationSelection();
+
+    // Method used in rank and fitness proportional selection for getting lambda positions of
+    // m_cumulativeSelectionWeights with stochastic universal sampling
+    void stochasticUniversalSampling();
+
+    // Shuffles the selected parents, so that the pairs of parents are random
+    void shuffleParents();
 
     // Update age of population
     void updateAgeOfPopulation(int currentGen);
 
     // Geter for m_populationArray
-    arrayOfIndividuals getPopulation();
+    const arrayOfIndividuals& getPopulation() const;
 };
 
 // Parent selection
 template <class RepresentationType, class FitnessValueType, class IndividualClass>
-arrayOfIndividuals Population<RepresentationType, FitnessValueType, IndividualClass>::
+void Population<RepresentationType, FitnessValueType, IndividualClass>::
 selectParentsFromPopulation()
 {
+    // The previous parents are removed, but the capacity of the array is kept
+    m_parentIndexes.clear();
+
     // Depending on the method used (m_parentSelectionMethod), it cals the
     // respective method
     switch (m_parentSelectionMethod)
     {
     case 0:
-        return tournamentSelection();
+        tournamentSelection();
         break;
-    
+
+    case 1:
+        linearRankSelection();
+        break;
+
+    case 2:
+        fitnessProportionalSelection();
+        break;
+
+    case 3:
+        truncationSelection();
+        break;
+
     default:
-        return tournamentSelection();
+        tournamentSelection();
         break;
     }
 }
@@ -152,233 +302,400 @@ selectParentsFromPopulation()
 // Mutations
 template <class RepresentationType, class FitnessValueType, class IndividualClass>
 void Population<RepresentationType, FitnessValueType, IndividualClass>::
-mutatePopulationDescendency(arrayOfIndividuals& descendency)
+mutatePopulationDescendency()
 {
-    // Foreach individual in population
-    auto it = descendency.begin();
-    while(it != descendency.end())
+    // Foreach pair of sons in descendency (in parallel)
+    m_threadPool->parallelFor(getNumberOfPairs(), [this](int pair)
     {
-        // Mutate the individual
-        it->mutateIndividual(this->m_pm_mutationProb);
-
-        it++;
-    }
+        // Mutate each son of the pair with the random number generator of the pair
+        for(int son = 2*pair; son < 2*pair + 2; son++)
+            m_descendencyArray[son].mutateIndividual(this->m_pm_mutationProb, m_pairRandomGenerators[pair]);
+    });
 }
 
-// Getter for the fitness value of the best individual
+// Seeds the random number generator of each pair of sons
 template <class RepresentationType, class FitnessValueType, class IndividualClass>
-FitnessValueType Population<RepresentationType, FitnessValueType, IndividualClass>::
-getTheBestFitnessValue()
+void Population<RepresentationType, FitnessValueType, IndividualClass>::
+seedPairRandomGenerators(int generation)
 {
-    // Each fitness value will be stored on this array
-    std::vector<FitnessValueType> fitnessValuesOnPopulation;
-
-    // For each individual in population
-    auto it = this->m_populationArray.begin();
-    while(it != this->m_populationArray.end())
+    // The stream of each generator is unique for each generation and pair, so it does not depend
+    // on which thread uses it
+    int nOfPairs = getNumberOfPairs();
+    m_pairRandomGenerators.resize(nOfPairs);
+    for(int pair = 0; pair < nOfPairs; pair++)
     {
-        // Get its fitness value
-        FitnessValueType fitnessValue = it->getFitnessValue();
-
-        // Add it to fitnessValuesOnPopulation
-        fitnessValuesOnPopulation.push_back(fitnessValue);
-
-        it++;
+        uint64_t stream = (static_cast<uint64_t>(generation) << 32) | static_cast<uint64_t>(pair);
+        m_pairRandomGenerators[pair].reseed(m_randomSeed, stream);
     }
+}
 
-    // Initialize the pointer that will point to the best fitness value in the next step
-    auto best_fitness_it = fitnessValuesOnPopulation.begin();
+// Number of pairs of parents of the current generation
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+int Population<RepresentationType, FitnessValueType, IndividualClass>::
+getNumberOfPairs() const
+{
+    return m_parentIndexes.size() / 2;
+}
 
-    // Get the best fitness value depending of it is a maximization or minimization task
-    if(m_maximization)
-        best_fitness_it = std::max_element(fitnessValuesOnPopulation.begin(), fitnessValuesOnPopulation.end());
-    else
-        best_fitness_it = std::min_element(fitnessValuesOnPopulation.begin(), fitnessValuesOnPopulation.end());
+// Getter for the length of the genotype
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+int Population<RepresentationType, FitnessValueType, IndividualClass>::
+getLengthOfTheGenotype() const
+{
+    return m_lengthOfTheGenotype;
+}
 
-    // Return the best fitness value
-    return (*best_fitness_it);  
+// Getter for the fitness value of the best individual
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+FitnessValueType Population<RepresentationType, FitnessValueType, IndividualClass>::
+getTheBestFitnessValue() const
+{
+    return getStatistics().bestFitnessValue;
 }
 
 // Getter for the best individual of the population
 template <class RepresentationType, class FitnessValueType, class IndividualClass>
-IndividualClass Population<RepresentationType, FitnessValueType, IndividualClass>::
-getTheBestIndividual()
+const IndividualClass& Population<RepresentationType, FitnessValueType, IndividualClass>::
+getTheBestIndividual() const
 {
-    // Each fitness value will be stored on this array
-    std::vector<FitnessValueType> fitnessValuesOnPopulation;
-
-    // Foreach individual in population
-    auto it = this->m_populationArray.begin();
-    while(it != this->m_populationArray.end())
-    {
-        FitnessValueType fitnessValue = it->getFitnessValue();
-        fitnessValuesOnPopulation.push_back(fitnessValue);
-        it++;
-    }
+    // Return a reference to the best individual, so that it is not copied
+    return this->m_populationArray[getStatistics().bestIndividualIdx];
+}
 
-    // Initialize the pointer that will point to the best fitness value in the next step
-    auto best_fitness_it = fitnessValuesOnPopulation.begin();
+// Getter for the position of the best individual on the population
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+int Population<RepresentationType, FitnessValueType, IndividualClass>::
+getTheBestIndividualIndex() const
+{
+    return getStatistics().bestIndividualIdx;
+}
 
-    // Get the best fitness value depending of it is a maximization or minimization task
-    if(m_maximization)
-        best_fitness_it = max_element(fitnessValuesOnPopulation.begin(), fitnessValuesOnPopulation.end());
-    else
-        best_fitness_it = min_element(fitnessValuesOnPopulation.begin(), fitnessValuesOnPopulation.end());
+// Getter for the positions of the k best individuals of the population
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+void Population<RepresentationType, FitnessValueType, IndividualClass>::
+getTheBestIndividualIndexes(int k, std::vector<int>& indexes) const
+{
+    // They are the first k positions of the bucket index, so nothing is sorted
+    const std::vector<int>& sortedIndexes = getBucketIndex().getSortedIndexes();
+    k = std::min(k, static_cast<int>(sortedIndexes.size()));
+    indexes.assign(sortedIndexes.begin(), sortedIndexes.begin() + k);
+}
 
-    // Get the position of the best individual in the array
-    int bestIndividualIdx = std::distance(fitnessValuesOnPopulation.begin(), best_fitness_it);
+// Getter for the position of the worst individual on the population
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+int Population<RepresentationType, FitnessValueType, IndividualClass>::
+getTheWorstIndividualIndex() const
+{
+    return getStatistics().worstIndividualIdx;
+}
 
-    // Get the best individual
-    IndividualClass bestIndividual = this->m_populationArray.at(bestIndividualIdx);
+// Replaces the worst individual of the population
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+void Population<RepresentationType, FitnessValueType, IndividualClass>::
+replaceTheWorstIndividual(const IndividualClass& individual)
+{
+    replaceIndividual(getBucketIndex().getWorstIndex(), individual);
+}
 
-    // Return it
-    return bestIndividual;
+// Replaces an individual of the population
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+void Population<RepresentationType, FitnessValueType, IndividualClass>::
+replaceIndividual(int index, const IndividualClass& individual)
+{
+    FitnessValueType oldFitnessValue = this->m_populationArray[index].getFitnessValue();
+    this->m_populationArray[index] = individual;
+
+    // The statistics are calculated again when they are needed, but the bucket index is only
+    // updated
+    m_outdatedStatistics = true;
+    if(!m_outdatedBucketIndex)
+        m_bucketIndex.update(index, oldFitnessValue, individual.getFitnessValue());
 }
 
 // Average fitness value of the population
 template <class RepresentationType, class FitnessValueType, class IndividualClass>
 float Population<RepresentationType, FitnessValueType, IndividualClass>::
-getAverageFitnessValue()
+getAverageFitnessValue() const
 {
-    // Each fitness value will be stored on this array
-    std::vector<FitnessValueType> fitnessValuesOnPopulation;
+    return getStatistics().averageFitnessValue;
+}
 
-    // For each individual in population
-    auto it = this->m_populationArray.begin();
-    while(it != this->m_populationArray.end())
+// Statistics of the population
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+const PopulationStatistics<FitnessValueType>& Population<RepresentationType, FitnessValueType, IndividualClass>::
+getStatistics() const
+{
+    if(!m_outdatedStatistics)
+        return m_statistics;
+
+    // Best and worst individuals found so far, and sums of the fitness values and their squares
+    int bestIndividualIdx = 0;
+    int worstIndividualIdx = 0;
+    FitnessValueType bestFitnessValue = this->m_populationArray[0].getFitnessValue();
+    FitnessValueType worstFitnessValue = bestFitnessValue;
+    double sumOfFitnessValues = 0.0;
+    double sumOfSquaredFitnessValues = 0.0;
+
+    // For each individual in population, compare its fitness value depending on whether it is a
+    // maximization or minimization task (the first best and worst individuals are kept on draws)
+    int nOfIndividuals = this->m_populationArray.size();
+    for(int i = 0; i < nOfIndividuals; i++)
     {
-        // Get its fitness value
-        FitnessValueType fitnessValue = it->getFitnessValue();
+        FitnessValueType fitnessValue = this->m_populationArray[i].getFitnessValue();
+        sumOfFitnessValues += fitnessValue;
+        sumOfSquaredFitnessValues += static_cast<double>(fitnessValue) * fitnessValue;
 
-        // Add it to fitnessValuesOnPopulation
-        fitnessValuesOnPopulation.push_back(fitnessValue);
-
-        it++;
+        if(m_maximization ? fitnessValue > bestFitnessValue : fitnessValue < bestFitnessValue)
+        {
+            bestFitnessValue = fitnessValue;
+            bestIndividualIdx = i;
+        }
+        if(m_maximization ? fitnessValue < worstFitnessValue : fitnessValue > worstFitnessValue)
+        {
+            worstFitnessValue = fitnessValue;
+            worstIndividualIdx = i;
+        }
     }
 
-    // Gets the sum of all fitness values
-    int sumOfVector = std::accumulate(fitnessValuesOnPopulation.begin(), fitnessValuesOnPopulation.end(), 0);
+    m_statistics.bestIndividualIdx = bestIndividualIdx;
+    m_statistics.worstIndividualIdx = worstIndividualIdx;
+    m_statistics.bestFitnessValue = bestFitnessValue;
+    m_statistics.worstFitnessValue = worstFitnessValue;
 
-    // Calculates the average
-    float averageFitnessValue = static_cast<float>(sumOfVector) / static_cast<float>(fitnessValuesOnPopulation.size());
+    // Mean and variance (mean of the squares minus the square of the mean)
+    double meanFitnessValue = sumOfFitnessValues / nOfIndividuals;
+    m_statistics.averageFitnessValue = static_cast<float>(sumOfFitnessValues) / static_cast<float>(nOfIndividuals);
+    m_statistics.fitnessVariance = static_cast<float>(std::max(0.0, sumOfSquaredFitnessValues / nOfIndividuals - meanFitnessValue * meanFitnessValue));
 
-    return averageFitnessValue;
+    m_outdatedStatistics = false;
+    return m_statistics;
 }
 
-// Tournament selection
+// Marks the statistics as outdated
 template <class RepresentationType, class FitnessValueType, class IndividualClass>
-arrayOfIndividuals Population<RepresentationType, FitnessValueType, IndividualClass>::
-tournamentSelection()
+void Population<RepresentationType, FitnessValueType, IndividualClass>::
+invalidateStatistics()
 {
-    // Array on which parents will be stored
-    arrayOfIndividuals parents_array;
+    m_outdatedStatistics = true;
+    m_outdatedBucketIndex = true;
+}
 
-    // Initialize the set containing all selectable parents indexn (all population)
-    std::set<int> selectableParents;
-    for(int i=0; i<m_populationLength; i++)
+// Bucket index of the population
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+const FitnessBucketIndex<FitnessValueType>& Population<RepresentationType, FitnessValueType, IndividualClass>::
+getBucketIndex() const
+{
+    if(m_outdatedBucketIndex)
     {
-        selectableParents.insert(i);
+        m_bucketIndex.build(this->m_populationArray, m_maximization);
+        m_outdatedBucketIndex = false;
     }
 
-    // Select lambda parents and store then on parents_array
+    return m_bucketIndex;
+}
+
+// Position of the individual of a rank
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+int Population<RepresentationType, FitnessValueType, IndividualClass>::
+getIndividualIndexOfRank(int rank) const
+{
+    return getBucketIndex().getIndexOfRank(rank);
+}
+
+// Tournament selection
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+void Population<RepresentationType, FitnessValueType, IndividualClass>::
+tournamentSelection()
+{
+    // Copies the fitness value of each individual to a contiguous array, so that tournaments
+    // do not have to access the individuals
+    int nOfIndividuals = this->m_populationArray.size();
+    m_tournamentFitnessValues.resize(nOfIndividuals);
+    for(int i=0; i<nOfIndividuals; i++)
+        m_tournamentFitnessValues[i] = this->m_populationArray[i].getFitnessValue();
+
+    // Initialize the pool containing all selectable parents indexes (all population). Its order
+    // does not matter, as tournaments shuffle it partially
+    m_selectableParents.resize(nOfIndividuals);
+    for(int i=0; i<nOfIndividuals; i++)
+        m_selectableParents[i] = i;
+
+    // Select lambda parents and store their indexes on m_parentIndexes
+    int nOfSelectableParents = nOfIndividuals;
     for(int i=0; i < m_lambda_nOfParentsSelected; i++)
-    {
-        IndividualClass parent = getIndividualFromTournament(selectableParents);
-        parents_array.push_back(parent);
-    }
-    
-    // return the parents array
-    return parents_array;
+        m_parentIndexes.push_back(getIndividualFromTournament(nOfSelectableParents));
 }
 
-// Method that gets individuals using tournament selection
+// Linear rank selection
 template <class RepresentationType, class FitnessValueType, class IndividualClass>
-IndividualClass Population<RepresentationType, FitnessValueType, IndividualClass>::
-getIndividualFromTournament(std::set<int>& selectableParents)
+void Population<RepresentationType, FitnessValueType, IndividualClass>::
+linearRankSelection()
 {
+    // The weight of each rank r (0 is the best one) decreases linearly from s (the selection
+    // pressure) to 2 - s, so that weights add up to N:
+    //      w(r) = (2 - s) + 2 * (s - 1) * (N - 1 - r) / (N - 1)
+    // The ranks are the ones of the bucket index, so the population is not sorted
+    const FitnessBucketIndex<FitnessValueType>& bucketIndex = this->getBucketIndex();
+    int nOfIndividuals = bucketIndex.size();
+    double pressure = m_rankSelectionPressure;
+    double slope = nOfIndividuals > 1 ? 2.0 * (pressure - 1.0) / (nOfIndividuals - 1) : 0.0;
+
+    m_cumulativeSelectionWeights.resize(nOfIndividuals);
+    double cumulativeWeight = 0.0;
+    for(int rank = 0; rank < nOfIndividuals; rank++)
+    {
+        cumulativeWeight += (2.0 - pressure) + slope * (nOfIndividuals - 1 - rank);
+        m_cumulativeSelectionWeights[rank] = cumulativeWeight;
+    }
 
-    // Copy selectableParents
-    std::set<int> selectableParentsInThisTournament = selectableParents;
+    // Selects lambda ranks and translates them to positions on the population
+    stochasticUniversalSampling();
+    for(int& parentIndex : m_parentIndexes)
+        parentIndex = bucketIndex.getIndexOfRank(parentIndex);
 
-    // Initilalize tournament winner index and fitness variables
-    FitnessValueType tournamentWinnerFitnessValue;
-    int tournamentWinnerIndex;
+    shuffleParents();
+}
 
-    // Array where the indexes of the individuals of the tournament will be stored
-    std::vector<int> tournamentIndividualsIndexes;
-    tournamentIndividualsIndexes.reserve(m_gamma);
+// Fitness proportional selection
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+void Population<RepresentationType, FitnessValueType, IndividualClass>::
+fitnessProportionalSelection()
+{
+    // The weight of each individual is its fitness value on maximization, and 1 / (1 + fitness value)
+    // on minimization (fitness values must not be negative), so that better individuals have
+    // greater weights
+    int nOfIndividuals = this->m_populationArray.size();
+    m_cumulativeSelectionWeights.resize(nOfIndividuals);
+    double cumulativeWeight = 0.0;
+    for(int i = 0; i < nOfIndividuals; i++)
+    {
+        double fitnessValue = this->m_populationArray[i].getFitnessValue();
+        cumulativeWeight += m_maximization ? fitnessValue : 1.0 / (1.0 + fitnessValue);
+        m_cumulativeSelectionWeights[i] = cumulativeWeight;
+    }
 
-    // Get a random element from selectableParentsInThisTournament
-    int index = get_random_element_setOfIntegers(selectableParentsInThisTournament);
+    stochasticUniversalSampling();
+    shuffleParents();
+}
 
-    // Set it as the winner
-    tournamentWinnerIndex = index;
-    tournamentWinnerFitnessValue = this->m_populationArray.at(index).getFitnessValue();
+// Truncation selection
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+void Population<RepresentationType, FitnessValueType, IndividualClass>::
+truncationSelection()
+{
+    // Only the best individuals (the first ranks of the bucket index) can be selected, all of them
+    // with the same probability
+    const FitnessBucketIndex<FitnessValueType>& bucketIndex = this->getBucketIndex();
+    int nOfSelectableParents = static_cast<int>(m_truncationProportion * bucketIndex.size());
+    nOfSelectableParents = std::min(std::max(nOfSelectableParents, 1), bucketIndex.size());
 
-    // Add it to tournamentIndividualsIndexes
-    tournamentIndividualsIndexes.emplace_back(index);
+    for(int i = 0; i < m_lambda_nOfParentsSelected; i++)
+    {
+        int rank = get_random_integer(m_randomGenerator, 0, nOfSelectableParents - 1);
+        m_parentIndexes.push_back(bucketIndex.getIndexOfRank(rank));
+    }
+}
 
-    // Delete it from selectableParentsInThisTournament as it cannot be selected twice on
-    // the same tournament
-    selectableParentsInThisTournament.erase(index);
+// Stochastic universal sampling
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+void Population<RepresentationType, FitnessValueType, IndividualClass>::
+stochasticUniversalSampling()
+{
+    // Lambda pointers equally spaced on [0, total weight) are placed from a single random number, and
+    // the position whose cumulative weight range contains each pointer is selected. As pointers
+    // are increasing, the table is walked only once
+    int nOfPositions = m_cumulativeSelectionWeights.size();
+    double totalWeight = m_cumulativeSelectionWeights.back();
+
+    // If all weights are 0 (on maximization, when every fitness value is 0), every position gets
+    // the same weight
+    if(totalWeight <= 0.0)
+    {
+        for(int i = 0; i < nOfPositions; i++)
+            m_cumulativeSelectionWeights[i] = i + 1;
+        totalWeight = nOfPositions;
+    }
+    double distance = totalWeight / m_lambda_nOfParentsSelected;
+    double pointer = get_random_float_0_to_1(m_randomGenerator) * distance;
 
-    // Get the rest of individuals of the tournament until having gamma individuals
-    for(int i=0; i<m_gamma-1; i++)
+    int position = 0;
+    for(int i = 0; i < m_lambda_nOfParentsSelected; i++)
     {
-        // Get random individual and its fitness value
-        index = get_random_element_setOfIntegers(selectableParentsInThisTournament);
-        FitnessValueType fitnessValue = this->m_populationArray.at(index).getFitnessValue();
+        while(position < nOfPositions - 1 && m_cumulativeSelectionWeights[position] <= pointer)
+            position++;
+        m_parentIndexes.push_back(position);
+        pointer += distance;
+    }
+}
 
-        // Add it to tournamentIndividualsIndexes
-        tournamentIndividualsIndexes.emplace_back(index);
+// Shuffles the selected parents
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+void Population<RepresentationType, FitnessValueType, IndividualClass>::
+shuffleParents()
+{
+    // Stochastic universal sampling selects parents in order, so consecutive parents (which are
+    // recombined together) would be equal or similar individuals (Fisher-Yates shuffle)
+    for(int i = static_cast<int>(m_parentIndexes.size()) - 1; i > 0; i--)
+        std::swap(m_parentIndexes[i], m_parentIndexes[get_random_integer(m_randomGenerator, 0, i)]);
+}
 
-        // Delete it from selectableParentsInThisTournament as it cannot be selected twice on
-        // the same tournament
-        selectableParentsInThisTournament.erase(index);
+// Method that gets individuals using tournament selection. The individuals of the tournament
+// are chosen from the first nOfSelectableParents positions of m_selectableParents with a partial
+// Fisher-Yates shuffle, so each tournament costs O(gamma) regardless of the population length
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+int Population<RepresentationType, FitnessValueType, IndividualClass>::
+getIndividualFromTournament(int& nOfSelectableParents)
+{
+    // If excluding tournament selection, the whole population may have been selected already (when
+    // lambda is greater than the length of the population). As m_selectableParents is still a
+    // permutation of all indexes, every individual becomes selectable again
+    if(nOfSelectableParents == 0)
+        nOfSelectableParents = m_selectableParents.size();
+
+    // If excluding tournament selection, there may be less selectable parents than gamma
+    int tournamentLength = std::min(static_cast<int>(m_gamma), nOfSelectableParents);
+
+    // Moves gamma different random indexes to the first positions of m_selectableParents. They
+    // are the individuals of the tournament
+    for(int i=0; i<tournamentLength; i++)
+    {
+        int randomPosition = get_random_integer(m_randomGenerator, i, nOfSelectableParents-1);
+        std::swap(m_selectableParents[i], m_selectableParents[randomPosition]);
+    }
 
+    // Gets the position (on m_selectableParents) of the best individual of the tournament
+    int tournamentWinnerPosition = 0;
+    FitnessValueType tournamentWinnerFitnessValue = m_tournamentFitnessValues[m_selectableParents[0]];
+    for(int i=1; i<tournamentLength; i++)
+    {
         // Evaluate the individual and if its better than the one that was the best, update
-        // tournamentWinnerFitnessValue and tournamentWinnerIndex
-        if(m_maximization)
-        {
-            if(fitnessValue > tournamentWinnerFitnessValue)
-            {
-                tournamentWinnerFitnessValue = fitnessValue;
-                tournamentWinnerIndex = index;
-            }
-        }
-        else
+        // tournamentWinnerFitnessValue and tournamentWinnerPosition
+        FitnessValueType fitnessValue = m_tournamentFitnessValues[m_selectableParents[i]];
+        if(m_maximization ? fitnessValue > tournamentWinnerFitnessValue : fitnessValue < tournamentWinnerFitnessValue)
         {
-            if(fitnessValue < tournamentWinnerFitnessValue)
-            {
-                tournamentWinnerFitnessValue = fitnessValue;
-                tournamentWinnerIndex = index;
-            }
+            tournamentWinnerFitnessValue = fitnessValue;
+            tournamentWinnerPosition = i;
         }
-        
     }
 
-    // Variable where the winner will be stored
-    IndividualClass tournamentWinner;
+    // Get random float number and compare it with m_p_bestParentSelectedProb (probability of selecting the best parent).
+    // If it is greater, a random individual from the tournament is selected instead of the tournament winner
+    float randomValue = get_random_float_0_to_1(m_randomGenerator);
+    if(randomValue > m_p_bestParentSelectedProb)
+        tournamentWinnerPosition = get_random_integer(m_randomGenerator, 0, tournamentLength-1);
 
-    // Get random float number and compare it with m_p_bestParentSelectedProb (probability of selecting the best parent)
-    float randomValue = get_random_float_0_to_1();
-    if(randomValue <= m_p_bestParentSelectedProb)
-        // Select the tournament winner
-        tournamentWinner = this->m_populationArray.at(tournamentWinnerIndex);
-    else
+    int tournamentWinnerIndex = m_selectableParents[tournamentWinnerPosition];
+
+    // If excluding tournament selection, exclude the winner so that it will no be choosen again. It is
+    // swapped with the last selectable parent, which is not selectable anymore
+    if(m_excludingTournament)
     {
-        // Select a random individual from the tournament
-        int randomIndex = get_random_integer(0, tournamentIndividualsIndexes.size()-1);
-        tournamentWinnerIndex = tournamentIndividualsIndexes.at(randomIndex);
-        tournamentWinner = this->m_populationArray.at(tournamentWinnerIndex);
+        nOfSelectableParents--;
+        std::swap(m_selectableParents[tournamentWinnerPosition], m_selectableParents[nOfSelectableParents]);
     }
     
-    // If excluding tournament selection, exclude the winner so that it will no be choosen again
-    if(m_excludingTournament)
-        selectableParents.erase(tournamentWinnerIndex);
-    
-    // Return the tournament winner
-    return tournamentWinner;
+    // Return the index of the tournament winner
+    return tournamentWinnerIndex;
 }
 
 // Update age of population
@@ -396,8 +713,8 @@ updateAgeOfPopulation(int currentGen)
 
 // Geter for m_populationArray
 template <class RepresentationType, class FitnessValueType, class IndividualClass>
-arrayOfIndividuals Population<RepresentationType, FitnessValueType, IndividualClass>::
-getPopulation()
+const arrayOfIndividuals& Population<RepresentationType, FitnessValueType, IndividualClass>::
+getPopulation() const
 {
     return m_populationArray;
 }
\ No newline at end of file
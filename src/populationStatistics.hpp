@@ -0,0 +1,37 @@
+#pragma once // Multiple inclusion guardian
+
+/*
+
+PopulationStatistics struct:
+
+Statistics of the fitness values of a population (population.hpp), all of them calculated on the
+same pass over the population by Population::getStatistics(). They are kept until the population
+changes, so that the stop condition, the logs and the survival selection of the same generation do
+not go over the population again. It has the following members:
+
+    - bestIndividualIdx and worstIndividualIdx: positions of the best and the worst individuals on
+      the population (the first ones on draws)
+    - bestFitnessValue and worstFitnessValue: their fitness values
+    - averageFitnessValue and fitnessVariance: mean and variance of all fitness values
+
+It has only one template parameter:
+
+    template <class FitnessValueType>
+
+which is the type of the fitness values of the individuals.
+
+*/
+
+template <class FitnessValueType>
+struct PopulationStatistics
+{
+    // Best and worst individuals
+    int bestIndividualIdx;
+    int worstIndividualIdx;
+    FitnessValueType bestFitnessValue;
+    FitnessValueType worstFitnessValue;
+
+    // Mean and variance of the fitness values
+    float averageFitnessValue;
+    float fitnessVariance;
+};
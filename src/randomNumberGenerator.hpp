@@ -0,0 +1,133 @@
+#pragma once // Multiple inclusion guardian
+
+#include <cstdint> // uint32_t, uint64_t
+
+/*
+
+RandomNumberGenerator class:
+
+A small and fast pseudo random number generator (xoshiro256**, by Blackman and Vigna) that replaces
+std::mt19937 + std::uniform_*_distribution. Its whole state is 32 bytes, so each part of the genetic
+algorithm that needs random numbers owns its own generator (its own stream) and receives it explicitly
+instead of sharing a global object.
+
+Generators are seeded deterministically from a seed and a stream number with splitmix64, so different
+streams of the same seed are independent and always produce the same numbers:
+
+    RandomNumberGenerator rng(randomSeed);          // stream 0 of randomSeed
+    RandomNumberGenerator rng(randomSeed, stream);  // another stream of randomSeed
+
+Bounded integers are sampled with Lemire's multiply-shift method (without the bias of a modulo), and
+floats use the 24 most significant bits of each number (two floats per 64 bits number with nextFloats()).
+
+*/
+
+class RandomNumberGenerator
+{
+
+// ATRIBUTES //
+
+private:
+
+    // State of xoshiro256**
+    uint64_t m_state[4];
+
+// METHODS //
+
+public:
+
+    // Constructor that seeds the generator from a seed and a stream number
+    explicit RandomNumberGenerator(uint64_t seed = 0, uint64_t stream = 0)
+    {
+        reseed(seed, stream);
+    }
+
+    // Sets the state of the generator from a seed and a stream number
+    void reseed(uint64_t seed, uint64_t stream = 0)
+    {
+        // The stream is mixed with the seed, and the state is filled with the next numbers of splitmix64
+        uint64_t splitmixState = seed;
+        uint64_t mixedStream = splitmix64(splitmixState) ^ stream;
+        splitmixState = mixedStream;
+        for(int i = 0; i < 4; i++)
+            m_state[i] = splitmix64(splitmixState);
+    }
+
+    // Returns the next 64 bits number
+    uint64_t next()
+    {
+        const uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+        const uint64_t t = m_state[1] << 17;
+
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotl(m_state[3], 45);
+
+        return result;
+    }
+
+    // Returns an integer between 0 and range-1 (range must be greater than 0)
+    uint32_t nextBounded(uint32_t range)
+    {
+        // Multiply-shift: the 32 high bits of a 32x32 bits product are uniform on [0, range) except
+        // for the low products that fall below threshold, which are rejected
+        uint64_t product = static_cast<uint64_t>(static_cast<uint32_t>(next() >> 32)) * range;
+        uint32_t low = static_cast<uint32_t>(product);
+        if(low < range)
+        {
+            uint32_t threshold = -range % range;
+            while(low < threshold)
+            {
+                product = static_cast<uint64_t>(static_cast<uint32_t>(next() >> 32)) * range;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    // Returns an integer between lower and upper (both included)
+    int nextInteger(int lower, int upper)
+    {
+        return lower + static_cast<int>(nextBounded(static_cast<uint32_t>(upper - lower) + 1));
+    }
+
+    // Returns a float on [0, 1)
+    float nextFloat()
+    {
+        return static_cast<float>(next() >> 40) * 0x1.0p-24f;
+    }
+
+    // Fills values with n floats on [0, 1), using each 64 bits number for two of them
+    void nextFloats(float* values, int n)
+    {
+        int i = 0;
+        for(; i + 1 < n; i += 2)
+        {
+            uint64_t bits = next();
+            values[i] = static_cast<float>(bits >> 40) * 0x1.0p-24f;
+            values[i+1] = static_cast<float>((bits >> 8) & 0xFFFFFF) * 0x1.0p-24f;
+        }
+        if(i < n)
+            values[i] = nextFloat();
+    }
+
+private:
+
+    // Rotates x k bits to the left
+    static uint64_t rotl(uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    // Returns the next number of splitmix64, updating its state
+    static uint64_t splitmix64(uint64_t& state)
+    {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+};
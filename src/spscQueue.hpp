@@ -0,0 +1,77 @@
+#pragma once // Multiple inclusion guardian
+
+#include <vector> // std::vector
+#include <atomic> // std::atomic
+#include <cstddef> // std::size_t
+
+#include "cacheAlignedAllocator.hpp" // CACHE_LINE_SIZE
+
+/*
+
+SpscQueue class:
+
+A bounded lock-free queue for one producer thread and one consumer thread (single producer, single
+consumer). It is a ring buffer whose write position (tail) is only modified by the producer and whose
+read position (head) is only modified by the consumer, so neither of them ever waits: tryPush() fails
+if the queue is full and tryPop() fails if it is empty.
+
+It is used on the island model (geneticAlgorithm.hpp) to send migrants from one island to another.
+
+It has only one template parameter:
+
+    template <class T>
+
+where T is the type of the elements, which must be default constructible and copy assignable.
+
+*/
+
+template <class T>
+class SpscQueue
+{
+
+// ATRIBUTES //
+
+private:
+
+    // Elements of the queue (one more than the capacity, so that a full queue is not empty)
+    std::vector<T> m_slots;
+
+    // Read and write positions, on different cache lines so that the producer and the consumer do not
+    // invalidate each other's cache
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_head;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_tail;
+
+// METHODS //
+
+public:
+
+    // Constructor that receives the maximum number of elements of the queue
+    explicit SpscQueue(std::size_t capacity): m_slots(capacity + 1), m_head(0), m_tail(0) {}
+
+    // Adds an element at the end of the queue (only called by the producer). Returns false if the
+    // queue is full
+    bool tryPush(const T& element)
+    {
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        std::size_t nextTail = (tail + 1) % m_slots.size();
+        if(nextTail == m_head.load(std::memory_order_acquire))
+            return false;
+
+        m_slots[tail] = element;
+        m_tail.store(nextTail, std::memory_order_release);
+        return true;
+    }
+
+    // Takes the first element of the queue (only called by the consumer). Returns false if the queue
+    // is empty
+    bool tryPop(T& element)
+    {
+        std::size_t head = m_head.load(std::memory_order_relaxed);
+        if(head == m_tail.load(std::memory_order_acquire))
+            return false;
+
+        element = m_slots[head];
+        m_head.store((head + 1) % m_slots.size(), std::memory_order_release);
+        return true;
+    }
+};
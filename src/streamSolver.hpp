@@ -0,0 +1,175 @@
+#pragma once // Multiple inclusion guardian
+
+#include <vector> // std::vector
+#include <memory> // std::unique_ptr
+#include <thread> // std::thread
+#include <mutex> // std::mutex, std::lock_guard
+#include <istream> // std::istream
+#include <ostream> // std::ostream
+#include <algorithm> // std::max
+
+#include "boundedQueue.hpp" // BoundedQueue
+#include "corpusSolver.hpp" // CorpusSolver::solveSudoku, CorpusSolver::writeResult
+#include "sudokuStreamReader.hpp" // SudokuStreamReader
+
+/*
+
+StreamSolver class:
+
+A class template that solves sudokus while they are being read from a stream (stdin or a file of any
+size), writing the result of each one as soon as it is solved. The calling thread reads the sudokus
+(with SudokuStreamReader, so both the 81 characters and the comma formats are accepted) and sends them
+through a bounded queue (boundedQueue.hpp) to the workers, each one with its own population that is
+reused for all the sudokus it solves. As the reader waits while the queue is full, the memory used does
+not depend on the number of sudokus of the stream.
+
+Results are written in the order in which sudokus are solved, with the same line format as the corpus
+mode (corpusSolver.hpp), whose first field is the number of the sudoku on the stream:
+
+    number of the sudoku, solved (1 or 0), generations, milliseconds, solution (or best individual)
+
+Each sudoku is solved with the random seed randomSeed + number of the sudoku, so its result is the same
+as on the corpus mode and does not depend on the worker that solves it.
+
+It has the same template parameters as GeneticAlgorithm (geneticAlgorithm.hpp):
+
+    template <class PopulationObject, class IndividualClass, class FileParametersObject>
+
+*/
+
+// Sudoku read from the stream, with its position on it
+struct StreamPuzzle
+{
+    long index;
+    std::vector<int> cells;
+};
+
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+class StreamSolver
+{
+
+// ATRIBUTES //
+
+private:
+
+    // Member that represents the struct that holds all file parameters
+    FileParametersObject m_fileParameters;
+
+    // Sudokus read that have not been taken by any worker yet
+    BoundedQueue<StreamPuzzle> m_puzzleQueue;
+
+    // Stream where results are written, and mutex that protects it and the counters below
+    std::ostream* m_resultsStream;
+    std::mutex m_resultsMutex;
+
+    // Number of sudokus read and solved
+    long m_nOfPuzzles;
+    long m_nOfSolvedPuzzles;
+
+// METHODS //
+
+public:
+
+    // Constructor that receives as parameter the FileParametersObject
+    StreamSolver(FileParametersObject fileParameters);
+    // Standard destructor
+    ~StreamSolver() {}
+
+    // Solves all sudokus of inputStream, writing their results on resultsStream. Returns when all of
+    // them have been solved
+    void solveStream(std::istream& inputStream, std::ostream& resultsStream);
+
+    // Getters for the number of sudokus read and solved
+    long getNumberOfPuzzles() const;
+    long getNumberOfSolvedPuzzles() const;
+
+private:
+
+    // Loop of each worker: solves sudokus of the queue until it is closed and empty
+    void workerLoop();
+};
+
+// Constructor
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+StreamSolver<PopulationObject, IndividualClass, FileParametersObject>::
+StreamSolver(FileParametersObject fileParameters): m_puzzleQueue(fileParameters.streamQueueCapacity)
+{
+    m_fileParameters = fileParameters;
+    m_resultsStream = nullptr;
+    m_nOfPuzzles = 0;
+    m_nOfSolvedPuzzles = 0;
+
+    // Parallelism is achieved solving many sudokus at the same time, so each population uses only
+    // one thread
+    m_fileParameters.numberOfThreads = 1;
+}
+
+// Solves all sudokus of the stream
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+void StreamSolver<PopulationObject, IndividualClass, FileParametersObject>::
+solveStream(std::istream& inputStream, std::ostream& resultsStream)
+{
+    m_resultsStream = &resultsStream;
+
+    // 0 workers means one worker per core
+    int nOfWorkers = m_fileParameters.numberOfCorpusWorkers;
+    if(nOfWorkers <= 0)
+        nOfWorkers = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<std::thread> workerThreads;
+    for(int worker = 0; worker < nOfWorkers; worker++)
+        workerThreads.emplace_back(&StreamSolver::workerLoop, this);
+
+    // The calling thread reads the sudokus and sends them to the workers
+    SudokuStreamReader sudokuStreamReader(inputStream);
+    StreamPuzzle puzzle;
+    while(sudokuStreamReader.readNextSudoku(puzzle.cells))
+    {
+        puzzle.index = m_nOfPuzzles++;
+        m_puzzleQueue.push(std::move(puzzle));
+    }
+
+    // Workers finish when they have solved the sudokus left on the queue
+    m_puzzleQueue.close();
+    for(std::thread& workerThread : workerThreads)
+        workerThread.join();
+}
+
+// Loop of each worker
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+void StreamSolver<PopulationObject, IndividualClass, FileParametersObject>::
+workerLoop()
+{
+    // Population of the worker (created when it solves its first sudoku)
+    std::unique_ptr<PopulationObject> population;
+
+    StreamPuzzle puzzle;
+    CorpusPuzzleResult result;
+    while(m_puzzleQueue.pop(puzzle))
+    {
+        CorpusSolver<PopulationObject, IndividualClass, FileParametersObject>::solveSudoku(
+            population, puzzle.cells, m_fileParameters.randomSeed + puzzle.index, m_fileParameters, result);
+
+        // Writes the result right away, so that the consumer of the stream does not wait for the rest
+        std::lock_guard<std::mutex> lock(m_resultsMutex);
+        CorpusSolver<PopulationObject, IndividualClass, FileParametersObject>::writeResult(*m_resultsStream, puzzle.index, result);
+        m_resultsStream->flush();
+        m_nOfSolvedPuzzles += result.solved;
+    }
+}
+
+// Getter for the number of sudokus read
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+long StreamSolver<PopulationObject, IndividualClass, FileParametersObject>::
+getNumberOfPuzzles() const
+{
+    return m_nOfPuzzles;
+}
+
+// Getter for the number of sudokus solved
+template <class PopulationObject, class IndividualClass, class FileParametersObject>
+long StreamSolver<PopulationObject, IndividualClass, FileParametersObject>::
+getNumberOfSolvedPuzzles() const
+{
+    return m_nOfSolvedPuzzles;
+}
@@ -1,59 +1,12 @@
 #pragma once // Multiple inclusion guardian
 
 #include "individual.hpp" // Individual class
-#include "utils.hpp" // Random distributions
-#include <set> // std::set
+#include "utils.hpp" // Random functions
+#include "sudokuTables.hpp" // sudokuTables
+#include "sudokuPuzzleContext.hpp" // SudokuPuzzleContext
 #include <vector> // std::vector
-
-// Vector of sets that contains the cell number of each row
-const std::vector<std::set<int>> coordinatesPerRow = {
-                                                        {1, 2, 3, 4, 5, 6, 7, 8, 9 }, // Row 1
-                                                        {10,11,12,13,14,15,16,17,18}, // Row 2
-                                                        {19,20,21,22,23,24,25,26,27}, // Row 3
-                                                        {28,29,30,31,32,33,34,35,36}, // Row 4
-                                                        {37,38,39,40,41,42,43,44,45}, // Row 5
-                                                        {46,47,48,49,50,51,52,53,54}, // Row 6
-                                                        {55,56,57,58,59,60,61,62,63}, // Row 7
-                                                        {64,65,66,67,68,69,70,71,72}, // Row 8
-                                                        {73,74,75,76,77,78,79,80,81}  // Row 9
-                                                        };
-
-
-// Vector of sets that contains the cell number of each column
-const std::vector<std::set<int>> coordinatesPerCol = {
-                                                        {1,10,19,28,37,46,55,64,73}, // Column 1
-                                                        {2,11,20,29,38,47,56,65,74}, // Column 2
-                                                        {3,12,21,30,39,48,57,66,75}, // Column 3
-                                                        {4,13,22,31,40,49,58,67,76}, // Column 4
-                                                        {5,14,23,32,41,50,59,68,77}, // Column 5
-                                                        {6,15,24,33,42,51,60,69,78}, // Column 6
-                                                        {7,16,25,34,43,52,61,70,79}, // Column 7
-                                                        {8,17,26,35,44,53,62,71,80}, // Column 8
-                                                        {9,18,27,36,45,54,63,72,81}  // Column 9
-                                                        };
-
-// Vector of sets that contains the cell number of each subgrid
-const std::vector<std::set<int>> corrdinatesPerSubgrid = {
-                                                            {1, 2, 3, 10,11,12,19,20,21}, // Subgrid 1
-                                                            {4, 5, 6, 13,14,15,22,23,24}, // Subgrid 2
-                                                            {7, 8, 9, 16,17,18,25,26,27}, // Subgrid 3
-                                                            {28,29,30,37,38,39,46,47,48}, // Subgrid 4
-                                                            {31,32,33,40,41,42,49,50,51}, // Subgrid 5
-                                                            {34,35,36,43,44,45,52,53,54}, // Subgrid 6
-                                                            {55,56,57,64,65,66,73,74,75}, // Subgrid 7
-                                                            {58,59,60,67,68,69,76,77,78}, // Subgrid 8
-                                                            {61,62,63,70,71,72,79,80,81}  // Subgrid 9
-                                                            };
-
-
-// Function that returns the row (1-9) of a certain position (1-81) in the sudoku
-int getRowFromPosition(int position);
-
-// Function that returns the column (1-9) of a certain position (1-81) in the sudoku
-int getColFromPosition(int position);
-
-// Function that returns the subgrid (1-9) of a certain position (1-81) in the sudoku
-int getSubgridFromPosition(int position);
+#include <array> // std::array
+#include <cstdint> // uint8_t, uint16_t
 
 /*
 
@@ -67,27 +20,59 @@ It has the same template parameters as Individual (individual.hpp):
 
     template <class RepresentationType, class FitnessValueType>
 
+The genotype only holds the values of the not fixed cells (genes), stored on a std::array of
+RepresentationType (uint8_t) so that copying an individual is a small memcpy without any memory
+allocation. Everything that does not change between individuals (fixed cells, which cell is each
+gene, initial legal values, ...) is stored on a SudokuPuzzleContext (sudokuPuzzleContext.hpp)
+shared by pointer by all individuals of the population.
+
 */
 
 template <class RepresentationType, class FitnessValueType>
-class SDK_Individual : public Individual<RepresentationType, FitnessValueType>
+class SDK_Individual : public Individual<RepresentationType, FitnessValueType, std::array<RepresentationType, SUDOKU_CELLS>>
 {
 
 // ATTRIBUTES //
 
-private:
+protected:
+
+    // Immutable information of the sudoku to be solved (shared by all individuals)
+    const SudokuPuzzleContext* m_puzzleContext;
 
     // Mutation method
     char m_mutation_method;
 
+    // Number of times each value (0-9) appears on each unit (rows, cols and subgrids, numbered as in
+    // sudokuTables.hpp). They allow to update the fitness value in O(1) each time a cell changes
+    std::array<std::array<uint8_t, 10>, SUDOKU_UNITS> m_unitValueCounts;
+
+    // If true, the fitness value is not updated incrementally when a cell changes. Instead, the
+    // individual is marked as pending and its fitness value is calculated later on a batch of
+    // individuals (batchFitnessEvaluation.hpp)
+    bool m_deferredFitnessEvaluation;
+
+    // Whether the fitness value and the unit counts are outdated (only on deferred evaluation)
+    bool m_pendingFitnessEvaluation;
+    bool m_outdatedUnitCounts;
+
+    // Zobrist hash of the genotype (see sudokuTables.hpp), updated each time a gene changes. Equal
+    // genotypes have equal hashes, so it identifies genotypes whose fitness value is already known
+    uint64_t m_genotypeHash;
+
 // METHODS //
 
 public:
 
+    // Whether the genes of each row are always a permutation of the values that are missing on it, so
+    // that recombination must exchange whole rows (see SDK_RowPermutationIndividual)
+    static constexpr bool ROW_PERMUTATION_GENOTYPE = false;
+
     // CONSTRUCTORS AND DESTRUCTOR //
 
-    // Constructor with creation generation, lenght of its genotype and intial values of the sudoku (read from a file)
-    SDK_Individual(int creationGen, unsigned int lengthOfTheGenotype, std::vector<int> sudokuInitialValues, char mutation_method);
+    // Constructor with creation generation, the context of the sudoku to be solved and the mutation method.
+    // The genotype is not initialized (see initializeIndividual())
+    SDK_Individual(int creationGen, const SudokuPuzzleContext* puzzleContext, char mutation_method,
+                   bool deferredFitnessEvaluation = false);
 
     // Default constructor and destructor
     SDK_Individual(){}
@@ -96,97 +81,97 @@ public:
     // IMPLEMENTATION OF THE PURE VIRTUAL METHODS OF Individual (individual.hpp) //
 
     // Method that initializes the individual (not fixed cells, fitness value, ...)
-    void initializeIndividual();
+    void initializeIndividual(RandomNumberGenerator& rng);
 
     // Method that calculates the fitness value of the individual
     void calculateFitnessValue();
 
     // Method that mutates the individual randomly
-    void mutateIndividual(float pm);
-
-    // Function that updates the member posibleValues of each SudokuCell (sudokuCell.hpp) so
-    // that the initialization and mutation is not completely random, but it uses the information
-    // that the current solution has (which cells are repeated on each row/col/subgrid, which ones
-    // do not appear and so on)
-    void updateLegalValuesOfEachCell();
-
-    // Method that initializes randomly each cell of the individual
-    void initializeAllCells();
-
-    // Functions that check and correct the individual's fixed cells when called. They are for debugging
-    // purpose so that the programmer ensures that fixed cells remain as such during generations
-    #if defined DEBUG_MODE_ON
-        bool checkFixedModified(std::vector<int> sudokuInitialValues);
-        void correctFixedModified(std::vector<int> sudokuInitialValues);
-    #endif
-};
+    void mutateIndividual(float pm, RandomNumberGenerator& rng);
 
-//Constructor 1
-template <class RepresentationType, class FitnessValueType>
-SDK_Individual<RepresentationType, FitnessValueType>::
-SDK_Individual(int creationGen, unsigned int lengthOfTheGenotype, std::vector<int> sudokuInitialValues, char mutation_method): 
-Individual<RepresentationType, FitnessValueType>(creationGen, lengthOfTheGenotype)
-{
-    // Stores the creation generation, the length of the genotype and the mutation method in memory
-    this->m_creationGen = creationGen;
-    this->m_lengthOfTheGenotype = lengthOfTheGenotype;
-    this->m_mutation_method = mutation_method;
+    // Function that calculates the bitmask of legal values of each gene so that the mutation is
+    // not completely random, but it uses the information that the current solution has (which
+    // cells are repeated on each row/col/subgrid, which ones do not appear and so on)
+    void calculateLegalValuesOfEachGene(std::array<uint16_t, SUDOKU_CELLS>& legalValuesOfEachGene);
 
-    // Reserves memory for the genotype
-    this->m_genotype.reserve(lengthOfTheGenotype);
+    // Method that initializes randomly each gene of the individual
+    void initializeAllCells(RandomNumberGenerator& rng);
 
-    // For each intial value of the sudoku initialized its respective cell
-    auto it = sudokuInitialValues.begin();
-    int i = 1;
-    while(it != sudokuInitialValues.end())
-    {
-        // sudokuInitialValues is a vector of 81 ints that represents each initial value 
-        // of the sudoku to be solved. All cells that are to be solved are represented with
-        // a 0. Fixed cells are represented with its value.
+    // Method that counts the values of each unit from scratch (m_unitValueCounts)
+    void countValuesOfEachUnit();
 
-        // Configure the cell with the info of sudokuInitialValues
-        // more info abut the struct available at sudokuCell.hpp
-        RepresentationType cell;
+    // Getter of the value of a cell (0-80), either fixed or not
+    int getCellValue(int cell) const;
 
-        // Saves the value of the cell
-        cell.cellValue = (*it);
+    // Getter of the value of a gene (0 to length of the genotype - 1)
+    int getGeneValue(int gene) const;
 
-        // Set whether is a fixed cell (not 0) or not (equal to 0)
-        if((*it) == 0)
-            cell.fixed = false;
-        else
-            cell.fixed = true;
+    // Setter of the value of a gene. Unit counts and fitness value are updated incrementally,
+    // so that every method that changes a gene (recombination, mutation, ...) must use it
+    void setGeneValue(int gene, int value);
 
-        // Gets its row, column and subgrid
-        cell.row = getRowFromPosition(i);
-        cell.col = getColFromPosition(i);
-        cell.subgrid = getSubgridFromPosition(i);
+    // Takes the genes of another individual on the positions whose mask is 0xFF and keeps its own
+    // genes on the positions whose mask is 0 (used by recombination). Genes are blended without
+    // branches, and unit counts and fitness value are calculated again only once at the end
+    void blendGenotype(const SDK_Individual& other, const std::array<uint8_t, SUDOKU_CELLS>& mask);
 
-        // Stores its cell number (1-81)
-        cell.cellNumber = i;
+    // Methods used on deferred fitness evaluation: whether the individual must be evaluated, copy
+    // of its cells to the position b of a batch of nOfBoards transposed boards and setter of the
+    // fitness value calculated on the batch
+    bool isFitnessEvaluationPending() const;
+    void copyCellsToBatch(uint8_t* boards, int nOfBoards, int b) const;
+    void setEvaluatedFitnessValue(FitnessValueType fitnessValue);
 
-        // Appends it to the genotype
-        this->m_genotype.emplace_back(cell);
+    // Getter of the Zobrist hash of the genotype
+    uint64_t getGenotypeHash() const;
 
-        it++;
-        i++;
-    }
+    // Local search (min-conflicts with a tabu list) that changes genes that are repeated on any of
+    // their units to the value that reduces the fitness value the most, during at most maxSteps steps
+    // or until the sudoku is solved. The individual ends up as the best one found during the search
+    void localSearch(int maxSteps, int tabuTenure, RandomNumberGenerator& rng);
+
+protected:
+
+    // Changes the value of a gene updating the unit counts and the fitness value incrementally
+    void updateGeneValue(int gene, int value);
+
+    // Calculates the Zobrist hash of the genotype from scratch (after the whole genotype is written)
+    void calculateGenotypeHash();
+};
 
-    // As the individual has changed, so has its legal value of each cell, 
-    // so it updates them
-    this->updateLegalValuesOfEachCell();
+//Constructor 1
+template <class RepresentationType, class FitnessValueType>
+SDK_Individual<RepresentationType, FitnessValueType>::
+SDK_Individual(int creationGen, const SudokuPuzzleContext* puzzleContext, char mutation_method,
+               bool deferredFitnessEvaluation):
+Individual<RepresentationType, FitnessValueType, std::array<RepresentationType, SUDOKU_CELLS>>(creationGen, puzzleContext->nOfFreeCells)
+{
+    // Stores the creation generation, the context of the sudoku and the mutation method in memory
+    this->m_creationGen = creationGen;
+    this->m_lengthOfTheGenotype = puzzleContext->nOfFreeCells;
+    this->m_puzzleContext = puzzleContext;
+    this->m_mutation_method = mutation_method;
+
+    // Stores how the fitness value is going to be evaluated
+    this->m_deferredFitnessEvaluation = deferredFitnessEvaluation;
+    this->m_pendingFitnessEvaluation = true;
+
+    // All genes are empty (0) until the individual is initialized, so that the unit counts are
+    // the ones of the fixed cells
+    this->m_genotype.fill(0);
+    this->m_unitValueCounts = puzzleContext->initialUnitValueCounts;
+    this->m_outdatedUnitCounts = true;
+    this->m_genotypeHash = 0;
 }
 
 // Initializes the individual
 template <class RepresentationType, class FitnessValueType>
 void SDK_Individual<RepresentationType, FitnessValueType>::
-initializeIndividual()
+initializeIndividual(RandomNumberGenerator& rng)
 {
     // Initializes each cell of the individual
-    this->initializeAllCells();
-
-    // Updates the new legal value of each cell
-    this->updateLegalValuesOfEachCell();
+    this->initializeAllCells(rng);
+    this->calculateGenotypeHash();
 
     // Calculates the fitness value of the initialized individual
     this->calculateFitnessValue();
@@ -201,325 +186,477 @@ calculateFitnessValue()
     /*
 
     Fitness function = (fitness_fi + fitness_ci + fitness_si) / 2, where:
-        - fitness_fi is the number of timer a value is repeated on each row * 2 
-        - fitness_ci is the number of timer a value is repeated on each column * 2 
-        - fitness_si is the number of timer a value is repeated on each subgrid * 2 
+        - fitness_fi is the number of timer a value is repeated on each row * 2
+        - fitness_ci is the number of timer a value is repeated on each column * 2
+        - fitness_si is the number of timer a value is repeated on each subgrid * 2
         - the / 2 term eliminates the * 2 term of the explained above
 
+    A value that appears c times on a unit is repeated c*(c-1) times (* 2 term included), so that
+    each term can be obtained from the number of times each value appears on each unit. Those counts
+    are kept by setGeneValue(), which updates the fitness value incrementally. This method calculates
+    everything from scratch.
+
     */
 
+    // Counts the values of each unit
+    this->countValuesOfEachUnit();
+
     // Separates the add terms as fi(repeated values on each row), ci(repeated values on each column)
     // and si(repeated values on each subgrid) as it
     int fitness_fi = 0;
     int fitness_ci = 0;
     int fitness_si = 0;
 
-    // For each cell in the sudoku
-    auto it = this->m_genotype.begin();
-    while(it != this->m_genotype.end())
+    // For each value on each row, column and subgrid
+    for(int i = 0; i < SUDOKU_UNIT_SIZE; i++)
     {
-        // calculates fitness_fi term (number of times the value on it is repeated on the row)
-
-        // Get the cell numbers of the row of cell i
-        std::set<int> positionsInCellsRow = coordinatesPerRow.at((it->row)-1);
-
-        // For each element in the row
-        auto pos = positionsInCellsRow.begin();
-        while(pos != positionsInCellsRow.end())
-        {
-            int checkValue = this->m_genotype[(*pos)-1].cellValue;
-            int checkCellNum = this->m_genotype[(*pos)-1].cellNumber;
-
-            // If the number of the cell on it is repeated, increase fitness_fi
-            if(checkValue == (it->cellValue) && checkCellNum != (it->cellNumber))
-                fitness_fi++;
-            pos++;
-        }
-
-        // calculates fitness_ci term (number of times the value on it is repeated on the column)
-
-        // Get the cell numbers of the column of cell i
-        std::set<int> positionsInCellsCol = coordinatesPerCol.at((it->col)-1);
-
-        // For each element in the col
-        pos = positionsInCellsCol.begin();
-        while(pos != positionsInCellsCol.end())
-        {
-            int checkValue = this->m_genotype[(*pos)-1].cellValue;
-            int checkCellNum = this->m_genotype[(*pos)-1].cellNumber;
-
-            // If the number of the cell on it is repeated, increase fitness_ci
-            if(checkValue == (it->cellValue) && checkCellNum != (it->cellNumber))
-                fitness_ci++;
-            pos++;
-        }
-
-        // calculates fitness_si term (number of times the value on it is repeated on the subgrid)
-
-        std::set<int> positionsInCellsSubgrid = corrdinatesPerSubgrid.at((it->subgrid)-1);
-
-        // For each element in the subgrid
-        pos = positionsInCellsSubgrid.begin();
-        while(pos != positionsInCellsSubgrid.end())
+        for(int value = 0; value <= 9; value++)
         {
-            int checkValue = this->m_genotype[(*pos)-1].cellValue;
-            int checkCellNum = this->m_genotype[(*pos)-1].cellNumber;
+            int rowCount = m_unitValueCounts[ROW_UNITS_OFFSET + i][value];
+            int colCount = m_unitValueCounts[COL_UNITS_OFFSET + i][value];
+            int subgridCount = m_unitValueCounts[SUBGRID_UNITS_OFFSET + i][value];
 
-            // If the number of the cell on it is repeated, increase fitness_si
-            if(checkValue == (it->cellValue) && checkCellNum != (it->cellNumber))
-                fitness_si++;
-            pos++;
+            fitness_fi += rowCount * (rowCount - 1);
+            fitness_ci += colCount * (colCount - 1);
+            fitness_si += subgridCount * (subgridCount - 1);
         }
-
-
-        it++;
     }
 
     // Calculates the fitness value
     this->m_fitnessValue = static_cast<FitnessValueType>(fitness_fi + fitness_ci + fitness_si) / 2.0f;
+    this->m_pendingFitnessEvaluation = false;
 
 }
 
 // Mutation of an individual
 template <class RepresentationType, class FitnessValueType>
 void SDK_Individual<RepresentationType, FitnessValueType>::
-mutateIndividual(float pm)
+mutateIndividual(float pm, RandomNumberGenerator& rng)
 {
-    // As recombination comes before mutation, legal values of each cell
-    // must be updated
-    this->updateLegalValuesOfEachCell();
-
-    // For each cell in the individual
-    auto it = this->m_genotype.begin();
-    while(it != this->m_genotype.end())
+    // Random values that decide whether each gene is mutated, all of them generated at once
+    std::array<float, SUDOKU_CELLS> randomValues;
+    rng.nextFloats(randomValues.data(), this->m_lengthOfTheGenotype);
+
+    // If no gene is going to be mutated, the individual does not change at all (and neither its
+    // fitness value), so legal values are not calculated
+    bool anyMutatedGene = false;
+    for(unsigned int gene = 0; gene < this->m_lengthOfTheGenotype; gene++)
+        anyMutatedGene |= randomValues[gene] <= pm;
+    if(!anyMutatedGene)
+        return;
+
+    // As recombination comes before mutation, legal values of each gene
+    // must be calculated
+    std::array<uint16_t, SUDOKU_CELLS> legalValuesOfEachGene;
+    this->calculateLegalValuesOfEachGene(legalValuesOfEachGene);
+
+    // For each gene in the individual (fixed cells are not part of the genotype)
+    for(unsigned int gene = 0; gene < this->m_lengthOfTheGenotype; gene++)
     {
-        // Only not fixed cells are mutable
-        if(!(it->fixed))
+        // Mutate if a random value is less than the probability of mutation
+        if(randomValues[gene] <= pm)
         {
-            // Mutate if a random value is less than the probability of mutation
-            float randomValue = get_random_float_0_to_1();
-            if(randomValue <= pm)
+            // If there are legal values for the gene to be mutated, only mutate to a
+            // randomly chosen one of them (legal values are the ones calculated before
+            // the mutation step, so that the order in which genes are mutated does not matter)
+            if(legalValuesOfEachGene[gene] != 0)
             {
-                // If there are legal values for the cell to be mutated, only mutate to a
-                // randomly chosen one of them 
-                if(!(it->posibleValues.empty()))
-                {
-                    // Get a random element from a std::set<int> and replace it at it->cellValue
-                    it->cellValue = get_random_element_setOfIntegers(it->posibleValues);
-                }
-                else
-                {
-                    // If there are not legal values, just mutate randomly
-                    it->cellValue = get_random_number_1_to_9();
-                }
+                // Get a random value from the bitmask and replace it at the gene
+                this->setGeneValue(gene, get_random_element_bitmask(rng, legalValuesOfEachGene[gene]));
+            }
+            else
+            {
+                // If there are not legal values, just mutate randomly
+                this->setGeneValue(gene, get_random_number_1_to_9(rng));
             }
         }
-        
-        it++;
     }
 
-    // As the individual has (probably) changed after mutation step, new legal values of 
-    // each cell and fitness value must be updated
-    this->calculateFitnessValue();
-    this->updateLegalValuesOfEachCell();
+    // The fitness value has been updated by setGeneValue() on each mutated gene
 
 }
 
-// Updates the legal value of each cell of an individual
+// Calculates the legal values of each gene of an individual
 template <class RepresentationType, class FitnessValueType>
 void SDK_Individual<RepresentationType, FitnessValueType>::
-updateLegalValuesOfEachCell()
+calculateLegalValuesOfEachGene(std::array<uint16_t, SUDOKU_CELLS>& legalValuesOfEachGene)
 {
     /*
 
-    OPERATION: Creates a std::set with the legal values on the cell's row (posibleRowValues),
+    OPERATION: Creates a bitmask with the legal values on the gene's row (posibleRowValues),
     columns (posibleColValues) and subgrid (posibleSubgridValues). At the same time, it creates
-    a std::set called legalValues that is the logical AND of the three of above (legal values taking
+    a bitmask called legalValues that is the logical AND of the three of above (legal values taking
     into account row, col and subgrid). It turns out this approach is very effective with sudokus with
     high fitness value, as they have a lot of repeated cells. Nevertheless, as the sudoku aproximates
     to the solution, is likely that no value is legal on rows, cols and subgrids at the same time. When
-    that happens, (only if mutation method 2 is selected) it does a logical OR of the three std::set 
+    that happens, (only if mutation method 2 is selected) it does a logical OR of the three bitmasks
     mentioned above, as it will mutate to a values that at least will be legal on row, col or subgrid.
 
     */
 
 
-    // For each cell on the individual
-    auto it = this->m_genotype.begin();
-    int currentCellNumber = 1;
-    while(it != this->m_genotype.end())
+    // On deferred fitness evaluation, unit counts are not updated by setGeneValue()
+    if(this->m_outdatedUnitCounts)
+        this->countValuesOfEachUnit();
+
+    // Bitmasks of the values that appear at least once and at least twice on each unit
+    std::array<uint16_t, SUDOKU_UNITS> valuesOnUnit;
+    std::array<uint16_t, SUDOKU_UNITS> repeatedValuesOnUnit;
+
+    // Calculates them from the counts of each unit
+    for(int unit = 0; unit < SUDOKU_UNITS; unit++)
     {
-        // legalValues is only needed on not fixed cells
-        if(!(it->fixed))
+        valuesOnUnit[unit] = 0;
+        repeatedValuesOnUnit[unit] = 0;
+        for(int value = 0; value <= 9; value++)
         {
-            // Initializes the set with all values, as each illegal value will be erased
-            std::set<int> legalValues = {1,2,3,4,5,6,7,8,9};
+            if(m_unitValueCounts[unit][value] > 0)
+                valuesOnUnit[unit] |= sudoku_value_bit(value);
+            if(m_unitValueCounts[unit][value] > 1)
+                repeatedValuesOnUnit[unit] |= sudoku_value_bit(value);
+        }
+    }
 
-            // Initializes posible values splitting by row, col or subgrid
-            it->posibleRowValues = legalValues;
-            it->posibleColValues = legalValues;
-            it->posibleSubgridValues = legalValues;
+    // For each gene on the individual
+    for(unsigned int gene = 0; gene < this->m_lengthOfTheGenotype; gene++)
+    {
+        // Values on the gene's row, col and subgrid are illegal, except its own value unless
+        // it is repeated (the gene itself must be excluded)
+        uint16_t ownValue = sudoku_value_bit(this->m_genotype[gene]);
+        const auto& units = m_puzzleContext->freeCellUnits[gene];
+        uint16_t illegalRowValues = (valuesOnUnit[units[0]] & ~ownValue) | (repeatedValuesOnUnit[units[0]] & ownValue);
+        uint16_t illegalColValues = (valuesOnUnit[units[1]] & ~ownValue) | (repeatedValuesOnUnit[units[1]] & ownValue);
+        uint16_t illegalSubgridValues = (valuesOnUnit[units[2]] & ~ownValue) | (repeatedValuesOnUnit[units[2]] & ownValue);
+
+        // Posible values splitting by row, col or subgrid (the bit of the value 0 of empty
+        // cells is dropped by the mask)
+        uint16_t posibleRowValues = ALL_SUDOKU_VALUES_MASK & ~illegalRowValues;
+        uint16_t posibleColValues = ALL_SUDOKU_VALUES_MASK & ~illegalColValues;
+        uint16_t posibleSubgridValues = ALL_SUDOKU_VALUES_MASK & ~illegalSubgridValues;
+
+        // Merges (logical AND) rows, cols and subgrids legal values
+        uint16_t legalValues = posibleRowValues & posibleColValues & posibleSubgridValues;
+
+        // If merging (logical AND) rows, cols and subgrids legal values the bitmask is empty
+        if(legalValues == 0 && this->m_mutation_method == 2)
+        {
+            // Do a logical OR with the legal values of each row, col and subgrid
+            legalValues = posibleRowValues | posibleColValues | posibleSubgridValues;
+        }
 
-            // Check illegal values in *it's row, col and subgrid //
+        legalValuesOfEachGene[gene] = legalValues;
+    }
 
-            // Rows //
+}
 
-            // Get the cell numbers that form the row of *it
-            std::set<int> positionsInCellsRow = coordinatesPerRow.at((it->row)-1);
+// Cells initializer
+template <class RepresentationType, class FitnessValueType>
+void SDK_Individual<RepresentationType, FitnessValueType>::
+initializeAllCells(RandomNumberGenerator& rng)
+{
+    // For each gene
+    for(unsigned int gene = 0; gene < this->m_lengthOfTheGenotype; gene++)
+    {
+        // Legal values of the gene taking into account only the fixed cells (the rest are empty
+        // before the initialization), precalculated on the context of the sudoku
+        uint16_t legalValues = m_puzzleContext->initialLegalValues[gene];
+        if(legalValues == 0 && this->m_mutation_method == 2)
+            legalValues = m_puzzleContext->initialRelaxedLegalValues[gene];
 
-            // For each element in the row
-            auto pos = positionsInCellsRow.begin();
-            while(pos != positionsInCellsRow.end())
-            {
-                // Erase its cellValue from the set of legal values
-                int illegalValue = this->m_genotype[(*pos)-1].cellValue;
-                if(this->m_genotype[(*pos)-1].cellNumber != currentCellNumber)
-                {
-                    legalValues.erase(illegalValue);
-                    it->posibleRowValues.erase(illegalValue);
-                }
-                pos++;
+        if(legalValues != 0)
+        {
+            // If the legal values of the gene are not empty, initialize it to one of them
+            this->m_genotype[gene] = get_random_element_bitmask(rng, legalValues);
+        }
+        else
+        {
+            // If all numbers between 1 and 9 are illegal pick one ramdomly
+            int random_val = get_random_number_1_to_9(rng);
+            this->m_genotype[gene] = random_val;
+        }
+    }
 
-            }
+    // Unit counts must be calculated again
+    this->m_outdatedUnitCounts = true;
+}
 
-            // Cols // 
+// Counts the values of each unit from scratch
+template <class RepresentationType, class FitnessValueType>
+void SDK_Individual<RepresentationType, FitnessValueType>::
+countValuesOfEachUnit()
+{
+    // Starts from the counts of the fixed cells
+    m_unitValueCounts = m_puzzleContext->initialUnitValueCounts;
 
-            // Get the cell numbers that form the column of *it
-            std::set<int> positionsInCellsCol = coordinatesPerCol.at((it->col)-1);
+    // Each gene increases the count of its value on its row, col and subgrid
+    for(unsigned int gene = 0; gene < this->m_lengthOfTheGenotype; gene++)
+    {
+        int geneValue = this->m_genotype[gene];
+        const auto& units = m_puzzleContext->freeCellUnits[gene];
+        m_unitValueCounts[units[0]][geneValue]++;
+        m_unitValueCounts[units[1]][geneValue]++;
+        m_unitValueCounts[units[2]][geneValue]++;
+    }
 
-            // For each element in the column
-            pos = positionsInCellsCol.begin();
-            while(pos != positionsInCellsCol.end())
-            {
-                if(this->m_genotype[(*pos)-1].cellNumber != currentCellNumber)
-                {
-                    // Erase its cellValue from the set of legal values
-                    int illegalValue = this->m_genotype[(*pos)-1].cellValue;
-                    legalValues.erase(illegalValue);
-                    it->posibleColValues.erase(illegalValue);
-                }
-                pos++;
-            }
+    this->m_outdatedUnitCounts = false;
+}
 
-            // Subgrids //
+// Getter of the value of a cell
+template <class RepresentationType, class FitnessValueType>
+int SDK_Individual<RepresentationType, FitnessValueType>::
+getCellValue(int cell) const
+{
+    // Fixed cells are read from the context and the rest from the genotype
+    int gene = m_puzzleContext->geneOfCell[cell];
+    if(gene < 0)
+        return m_puzzleContext->initialValues[cell];
+    return this->m_genotype[gene];
+}
 
-            // Get the cell numbers that form the subgrid of *it
-            std::set<int> positionsInCellsSubgrids = corrdinatesPerSubgrid.at((it->subgrid)-1);
+// Getter of the value of a gene
+template <class RepresentationType, class FitnessValueType>
+int SDK_Individual<RepresentationType, FitnessValueType>::
+getGeneValue(int gene) const
+{
+    return this->m_genotype[gene];
+}
 
-            // For each element in the subgrid
-            pos = positionsInCellsSubgrids.begin();
-            while(pos != positionsInCellsSubgrids.end())
-            {
-                if(this->m_genotype[(*pos)-1].cellNumber != currentCellNumber)
-                {
-                    // Erase its cellValue from the set of legal values
-                    int illegalValue = this->m_genotype[(*pos)-1].cellValue;
-                    legalValues.erase(illegalValue);
-                    it->posibleSubgridValues.erase(illegalValue);
-                }
-                pos++;
-            }
+// Setter of the value of a gene
+template <class RepresentationType, class FitnessValueType>
+void SDK_Individual<RepresentationType, FitnessValueType>::
+setGeneValue(int gene, int value)
+{
+    int oldValue = this->m_genotype[gene];
 
-            // If merging (logical NAND) rows, cols and subgrids ilegal values the set is empty
-            if(legalValues.empty() && this->m_mutation_method == 2)
-            {
-                // Do a logical NOR with the illegal value of each row, col and subgrid
-                if(!it->posibleRowValues.empty())
-                    legalValues.insert(it->posibleRowValues.begin(), it->posibleRowValues.end());
+    // Nothing changes if the value is the same
+    if(oldValue == value)
+        return;
 
-                if(!it->posibleColValues.empty())
-                    legalValues.insert(it->posibleColValues.begin(), it->posibleColValues.end());
+    // On deferred fitness evaluation, the individual is just marked to be evaluated later
+    if(this->m_deferredFitnessEvaluation)
+    {
+        this->m_genotype[gene] = value;
+        this->m_genotypeHash ^= sudokuTables.zobristKeys[gene][oldValue] ^ sudokuTables.zobristKeys[gene][value];
+        this->m_pendingFitnessEvaluation = true;
+        this->m_outdatedUnitCounts = true;
+        return;
+    }
 
-                if(!it->posibleSubgridValues.empty())
-                    legalValues.insert(it->posibleSubgridValues.begin(), it->posibleSubgridValues.end());
-            }
+    updateGeneValue(gene, value);
+}
 
-            it->posibleValues = legalValues;
-        }
+// Blends the genotype with the one of another individual
+template <class RepresentationType, class FitnessValueType>
+void SDK_Individual<RepresentationType, FitnessValueType>::
+blendGenotype(const SDK_Individual& other, const std::array<uint8_t, SUDOKU_CELLS>& mask)
+{
+    // Every position of the genotype is blended (the mask is 0 after the last gene), so that the
+    // loop has a fixed number of iterations and the compiler turns it into a few SIMD instructions.
+    // The changed bits of all genes are accumulated to know whether any gene has changed
+    RepresentationType changedBits = 0;
+    for(int gene = 0; gene < SUDOKU_CELLS; gene++)
+    {
+        RepresentationType geneChange = (this->m_genotype[gene] ^ other.m_genotype[gene]) & mask[gene];
+        this->m_genotype[gene] ^= geneChange;
+        changedBits |= geneChange;
+    }
+
+    // If no gene has changed (both parents have the same values on the masked genes), the fitness
+    // value and the unit counts are still valid
+    if(changedBits == 0)
+        return;
 
-        it++;
-        currentCellNumber++;
+    this->calculateGenotypeHash();
+
+    // On deferred fitness evaluation, the individual is just marked to be evaluated later
+    if(this->m_deferredFitnessEvaluation)
+    {
+        this->m_pendingFitnessEvaluation = true;
+        this->m_outdatedUnitCounts = true;
+        return;
     }
 
+    // Many genes may have changed, so units are counted again from scratch instead of updating
+    // them gene by gene
+    this->calculateFitnessValue();
 }
 
-// Cells initializer
+// Changes the value of a gene updating the unit counts and the fitness value
 template <class RepresentationType, class FitnessValueType>
 void SDK_Individual<RepresentationType, FitnessValueType>::
-initializeAllCells()
+updateGeneValue(int gene, int value)
 {
-    
-    // For each cell
-    auto it = this->m_genotype.begin();
-    while(it != this->m_genotype.end())
+    int oldValue = this->m_genotype[gene];
+    this->m_genotype[gene] = value;
+    this->m_genotypeHash ^= sudokuTables.zobristKeys[gene][oldValue] ^ sudokuTables.zobristKeys[gene][value];
+
+    // On each unit of the gene, the old value loses (count - 1) repetitions and the new
+    // one gains count repetitions (fitness function is explained on calculateFitnessValue())
+    const auto& units = m_puzzleContext->freeCellUnits[gene];
+    for(int i = 0; i < 3; i++)
     {
+        std::array<uint8_t, 10>& unitCounts = m_unitValueCounts[units[i]];
 
-        // It only needs to be initialized if its not fixed
-        if(!(it->fixed))
-        {
-            if(!(it->posibleValues.empty()))
-            {
-                // If the posibleValues of the cell is not empty, initialize it to a legal value
-                // calculated on updateLegalValuesOfEachCell()
-                it->cellValue = get_random_element_setOfIntegers(it->posibleValues);
-            }
-            else
-            {
-                // If all numbers between 1 and 9 are illegal pick one ramdomly
-                int random_val = get_random_number_1_to_9();
-                it->cellValue = random_val;
-            }
-        }
+        unitCounts[oldValue]--;
+        this->m_fitnessValue -= unitCounts[oldValue];
 
-        it++;
+        this->m_fitnessValue += unitCounts[value];
+        unitCounts[value]++;
     }
 }
 
-#if defined DEBUG_MODE_ON
+// Whether the fitness value must be calculated
+template <class RepresentationType, class FitnessValueType>
+bool SDK_Individual<RepresentationType, FitnessValueType>::
+isFitnessEvaluationPending() const
+{
+    return this->m_pendingFitnessEvaluation;
+}
 
-    // Checks if any fixed cell has been modified (debugging purpouse)
-    template <class RepresentationType, class FitnessValueType>
-    bool SDK_Individual<RepresentationType, FitnessValueType>::
-    checkFixedModified(std::vector<int> sudokuInitialValues)
+// Getter of the Zobrist hash of the genotype
+template <class RepresentationType, class FitnessValueType>
+uint64_t SDK_Individual<RepresentationType, FitnessValueType>::
+getGenotypeHash() const
+{
+    return this->m_genotypeHash;
+}
+
+// Calculates the Zobrist hash of the genotype
+template <class RepresentationType, class FitnessValueType>
+void SDK_Individual<RepresentationType, FitnessValueType>::
+calculateGenotypeHash()
+{
+    uint64_t genotypeHash = 0;
+    for(unsigned int gene = 0; gene < this->m_lengthOfTheGenotype; gene++)
+        genotypeHash ^= sudokuTables.zobristKeys[gene][this->m_genotype[gene]];
+    this->m_genotypeHash = genotypeHash;
+}
+
+// Copies the cells of the individual to the position b of a batch of transposed boards
+template <class RepresentationType, class FitnessValueType>
+void SDK_Individual<RepresentationType, FitnessValueType>::
+copyCellsToBatch(uint8_t* boards, int nOfBoards, int b) const
+{
+    for(int cell = 0; cell < SUDOKU_CELLS; cell++)
+        boards[cell * nOfBoards + b] = this->getCellValue(cell);
+}
+
+// Setter of the fitness value calculated on a batch
+template <class RepresentationType, class FitnessValueType>
+void SDK_Individual<RepresentationType, FitnessValueType>::
+setEvaluatedFitnessValue(FitnessValueType fitnessValue)
+{
+    this->m_fitnessValue = fitnessValue;
+    this->m_pendingFitnessEvaluation = false;
+}
+
+// Local search
+template <class RepresentationType, class FitnessValueType>
+void SDK_Individual<RepresentationType, FitnessValueType>::
+localSearch(int maxSteps, int tabuTenure, RandomNumberGenerator& rng)
+{
+    /*
+
+    OPERATION: on each step, a gene whose value is repeated on its row, col or subgrid is chosen
+    randomly and changed to the value with the lowest fitness value (ties are broken randomly), even if
+    it is worse than the current one, so that the search can leave local minima. The change of the
+    fitness value of each posible value is calculated in O(1) from the unit counts, as on
+    setGeneValue(). To avoid undoing the last changes, the old value of a changed gene is tabu during
+    tabuTenure steps, unless it leads to a better individual than the best one found.
+
+    */
+
+    // Unit counts and the fitness value must be up to date (on deferred fitness evaluation they are
+    // not updated by setGeneValue()), and they are updated incrementally during the search
+    if(this->m_pendingFitnessEvaluation)
+        this->calculateFitnessValue();
+    else if(this->m_outdatedUnitCounts)
+        this->countValuesOfEachUnit();
+
+    // Best individual found during the search
+    FitnessValueType bestFitnessValue = this->m_fitnessValue;
+    std::array<RepresentationType, SUDOKU_CELLS> bestGenotype = this->m_genotype;
+    std::array<std::array<uint8_t, 10>, SUDOKU_UNITS> bestUnitValueCounts = m_unitValueCounts;
+
+    // Step until which each value of each gene is tabu
+    std::array<int, SUDOKU_CELLS * 10> tabuUntilStep;
+    tabuUntilStep.fill(0);
+
+    std::array<uint8_t, SUDOKU_CELLS> conflictedGenes;
+    for(int step = 1; step <= maxSteps && this->m_fitnessValue > 0; step++)
     {
-        // For each cell of the sudoku
-        auto it = this->m_genotype.begin();
-        int i = 0;
-        while(it != this->m_genotype.end())
+        // Genes whose value is repeated on any of their units
+        int nOfConflictedGenes = 0;
+        for(unsigned int gene = 0; gene < this->m_lengthOfTheGenotype; gene++)
         {
-            
-            // If its fixed and its value is different to the initial
-            // Incorrect cell -> return false
-            if(it->fixed) 
-                if(it->cellValue != sudokuInitialValues.at(i))
-                    return false;
-
-            it++;
-            i++;
-            
+            int geneValue = this->m_genotype[gene];
+            const auto& units = m_puzzleContext->freeCellUnits[gene];
+            if(m_unitValueCounts[units[0]][geneValue] > 1 || m_unitValueCounts[units[1]][geneValue] > 1 ||
+               m_unitValueCounts[units[2]][geneValue] > 1)
+                conflictedGenes[nOfConflictedGenes++] = gene;
         }
 
-        return  true;
-    }
+        // Only fixed cells are repeated, so no change can reduce the fitness value
+        if(nOfConflictedGenes == 0)
+            break;
 
-    // Corrects all mistakenly modified fixed cells
-    template <class RepresentationType, class FitnessValueType>
-    void SDK_Individual<RepresentationType, FitnessValueType>::
-    correctFixedModified(std::vector<int> sudokuInitialValues)
-    {
-        // For each cell of the sudoku
-        auto it = this->m_genotype.begin();
-        int i = 0;
-        while(it != this->m_genotype.end())
+        int gene = conflictedGenes[rng.nextInteger(0, nOfConflictedGenes - 1)];
+        int oldValue = this->m_genotype[gene];
+        const auto& units = m_puzzleContext->freeCellUnits[gene];
+
+        // Repetitions that the gene removes if it leaves its value
+        int removedRepetitions = (m_unitValueCounts[units[0]][oldValue] - 1) + (m_unitValueCounts[units[1]][oldValue] - 1) +
+                                 (m_unitValueCounts[units[2]][oldValue] - 1);
+
+        // Value with the lowest change of the fitness value among the not tabu ones
+        int chosenValue = 0;
+        int chosenDelta = 0;
+        int nOfTies = 0;
+        for(int value = 1; value <= 9; value++)
         {
-            // If its fixed and its value is different to the initial
-            // Incorrect cell -> correct it
-            if(it->fixed)
-                it->cellValue = sudokuInitialValues[i];
+            if(value == oldValue)
+                continue;
+
+            int delta = m_unitValueCounts[units[0]][value] + m_unitValueCounts[units[1]][value] +
+                        m_unitValueCounts[units[2]][value] - removedRepetitions;
 
-            it++;
-            i++;
+            // Tabu values are only allowed if they lead to the best individual found (aspiration)
+            if(tabuUntilStep[gene * 10 + value] >= step && this->m_fitnessValue + delta >= bestFitnessValue)
+                continue;
+
+            if(nOfTies == 0 || delta < chosenDelta)
+            {
+                chosenValue = value;
+                chosenDelta = delta;
+                nOfTies = 1;
+            }
+            else if(delta == chosenDelta && rng.nextInteger(0, nOfTies++) == 0)
+                chosenValue = value;
+        }
+
+        if(chosenValue == 0)
+            continue;
+
+        updateGeneValue(gene, chosenValue);
+        tabuUntilStep[gene * 10 + oldValue] = step + tabuTenure;
+
+        if(this->m_fitnessValue < bestFitnessValue)
+        {
+            bestFitnessValue = this->m_fitnessValue;
+            bestGenotype = this->m_genotype;
+            bestUnitValueCounts = m_unitValueCounts;
         }
     }
 
-#endif
\ No newline at end of file
+    // The individual ends up as the best one found
+    if(this->m_fitnessValue > bestFitnessValue)
+    {
+        this->m_fitnessValue = bestFitnessValue;
+        this->m_genotype = bestGenotype;
+        m_unitValueCounts = bestUnitValueCounts;
+        this->calculateGenotypeHash();
+    }
+
+    this->m_pendingFitnessEvaluation = false;
+    this->m_outdatedUnitCounts = false;
+}
@@ -2,9 +2,15 @@
 
 #include "population.hpp" // Population class
 #include "fileParameters.hpp" // FileParameters class
+#include "batchFitnessEvaluation.hpp" // evaluate_fitness_of_board_range
+#include "sudokuPuzzleContext.hpp" // SudokuPuzzleContext
+#include "fitnessCache.hpp" // FitnessCache
 #include <iostream> //std::cout, std::endl
-#include <algorithm> // std::copy
+#include <algorithm> // std::copy, std::max, std::min, std::nth_element, std::sort
 #include <vector> // std::vector
+#include <memory> // std::shared_ptr
+#include <array> // std::array
+#include <cstdint> // uint8_t, uint64_t
 
 /*
 
@@ -17,6 +23,10 @@ It has the same template parameters as Population (population.hpp):
 
     template <class RepresentationType, class FitnessValueType, class IndividualClass>
 
+Sons are written directly on the descendency arena (m_descendencyArray) from the parents selected on
+the current population, and both arenas are swapped on survival selection (or, on the steady-state
+model, sons replace some individuals of the current population in place), so no memory is allocated
+after the population has been initialized.
 
 */
 
@@ -28,13 +38,32 @@ class SDK_Population : public Population<RepresentationType, FitnessValueType, I
 
 private:
 
-    // Vector of 81 ints that contains the initial values (read from a file) of
-    // the sudoku problem to be solved
-    std::vector<int> m_initialSudokuCells;
+    // Immutable information of the sudoku problem to be solved (built from the initial values
+    // read from a file), shared by all individuals of the population
+    std::shared_ptr<const SudokuPuzzleContext> m_puzzleContext;
 
     // FileParameters type member that contain all file parameters
     FileParameters m_fileParameters;
 
+    // Buffers used on batch fitness evaluation (transposed boards, their fitness values and the
+    // index of the individual of each board). They are kept between generations to reuse memory
+    std::vector<uint8_t> m_batchBoards;
+    std::vector<int> m_batchFitnessValues;
+    std::vector<int> m_batchIndividuals;
+
+    // Fitness values of the genotypes already evaluated on batch fitness evaluation, indexed by
+    // their hash (disabled if fitnessCacheSize is 0)
+    FitnessCache<FitnessValueType> m_fitnessCache;
+
+    // Sons ordered by fitness value (to get the ones improved by local search) and the random number
+    // generator of each improved son
+    FitnessBucketIndex<FitnessValueType> m_descendencyBucketIndex;
+    std::vector<RandomNumberGenerator> m_localSearchRandomGenerators;
+
+    // Positions used on survival selection (candidates to survive and elites), kept between
+    // generations to reuse memory
+    std::vector<int> m_survivalIndexes;
+    std::vector<int> m_eliteIndexes;
 
 // METHODS //
 
@@ -42,198 +71,547 @@ public:
 
     // CONSTRUCTOR AND DESTRUCTOR //
 
-    // Constructor
+    // Constructor that builds the context of the sudoku from its initial cells
     SDK_Population(FileParameters fileParameters, std::vector<int> initialSudokuCells);
+    // Constructor that shares the context of a sudoku with other populations (for instance, the
+    // islands of the island model, so that migrants point to the same context on any island)
+    SDK_Population(FileParameters fileParameters, std::shared_ptr<const SudokuPuzzleContext> puzzleContext);
     // Standard destructor
     ~SDK_Population() {}
 
     // Methods corresponding to the recombination step
-    arrayOfIndividuals recombineParents(arrayOfIndividuals parents, int generation);
-    arrayOfIndividuals onePointRecombination(arrayOfIndividuals parents, int generation);
+    void recombineParents(int generation);
+    void buildCrossoverMask(int crossoverMethod, RandomNumberGenerator& rng, std::array<uint8_t, SUDOKU_CELLS>& mask) const;
+
+    // Method corresponding to the evaluation step
+    void evaluatePopulationDescendency();
+
+    // Method corresponding to the local search step (on the best sons)
+    void improveDescendency(int generation);
 
     // Methods corresponding to survival selection step
-    void selectSurvivals(arrayOfIndividuals currentPopulationDescendency);
+    void selectSurvivals();
     void survivalSelection_generationalModel();
+    void survivalSelection_descendencyReplacesParents();
+    void survivalSelection_muPlusLambda();
+    void survivalSelection_muCommaLambda();
+    void survivalSelection_steadyStateModel();
+    void keepElitesOnDescendency();
+    int getReplacementTournamentLoser();
+
+    // Positions of the k best individuals of an array and of the k worst ones among its first n ones
+    // (on the first k positions of indexes, in any order)
+    void getBestIndexes(const arrayOfIndividuals& individuals, int k, std::vector<int>& indexes) const;
+    void getWorstIndexes(const arrayOfIndividuals& individuals, int n, int k, std::vector<int>& indexes) const;
 
     // Initializer of the population
     void initializePopulation();
 
+    // Changes the sudoku to be solved and the random seed, and initializes the population again
+    // reusing its memory (used when many sudokus are solved one after another)
+    void resetPuzzle(const std::vector<int>& initialSudokuCells, int randomSeed);
+
+    // Getter of the context of the sudoku
+    const std::shared_ptr<const SudokuPuzzleContext>& getPuzzleContext() const;
+
     // Getter of the best individual provided an array of them
-    IndividualClass getBestIndividualOfDescendency(arrayOfIndividuals descendency);
+    const IndividualClass& getBestIndividualOfDescendency(const arrayOfIndividuals& descendency) const;
 
 };
 
-// Constructor
+// Constructor from the initial cells of the sudoku. It builds the context of the sudoku (fixing the
+// cells deduced by constraint propagation, if it is applied)
 template <class RepresentationType, class FitnessValueType, class IndividualClass>
 SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
 SDK_Population(FileParameters fileParameters, std::vector<int> initialSudokuCells):
+SDK_Population(fileParameters, std::make_shared<const SudokuPuzzleContext>(initialSudokuCells, fileParameters.constraintPropagation))
+{
+}
+
+// Constructor from a shared context of the sudoku
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
+SDK_Population(FileParameters fileParameters, std::shared_ptr<const SudokuPuzzleContext> puzzleContext):
 Population<RepresentationType, FitnessValueType, IndividualClass>()
 {
     // Sets the m_fileParameters member
     m_fileParameters = fileParameters;
 
+    // Creates the cache of fitness values (only used on batch fitness evaluation)
+    if(fileParameters.batchFitnessEvaluation)
+        m_fitnessCache = FitnessCache<FitnessValueType>(fileParameters.fitnessCacheSize);
+
     // Sets all parameters defined on population.hpp
     this->m_populationLength = fileParameters.populationLength;
-    this->m_lengthOfTheGenotype = initialSudokuCells.size();
     this->m_gamma = fileParameters.gamma_tournamentSelection;
     this->m_p_bestParentSelectedProb = fileParameters.p_bestParentSelectedProb;
     this->m_maximization = fileParameters.maximizationProblem;
     this->m_excludingTournament = fileParameters.excludingTournament;
     this->m_parentSelectionMethod = fileParameters.parentSelectionMethod;
-    this->m_lambda_nOfParentsSelected = fileParameters.lambda_nOfParentsSelected;
+    this->m_rankSelectionPressure = fileParameters.rankSelectionPressure;
+    this->m_truncationProportion = fileParameters.truncationProportion;
+    // Lambda is rounded up to an even number (as the configuration file reader does), as parents
+    // are recombined in pairs
+    this->m_lambda_nOfParentsSelected = fileParameters.lambda_nOfParentsSelected + fileParameters.lambda_nOfParentsSelected % 2;
     this->m_pm_mutationProb = fileParameters.pm_mutationProb;
     this->m_pc_crossoverProb = fileParameters.pc_crossoverProb;
 
-    // Sets the m_initialSudokuCells member
-    m_initialSudokuCells = initialSudokuCells;
+    // Seeds the random number generator of the population
+    this->m_randomSeed = fileParameters.randomSeed;
+    this->m_randomGenerator.reseed(fileParameters.randomSeed);
+
+    // Creates the threads used on recombination, mutation and evaluation
+    this->m_threadPool.reset(new ThreadPool(fileParameters.numberOfThreads));
 
-    // Allocates memory for population
-    this->m_populationArray.reserve(fileParameters.populationLength);
+    // Only the not fixed cells of the sudoku are part of the genotype
+    m_puzzleContext = puzzleContext;
+    this->m_lengthOfTheGenotype = m_puzzleContext->nOfFreeCells;
+
+    // Allocates memory for both arenas (current population and descendency) and for the indexes of
+    // the parents. As the arenas are swapped, both of them must be able to hold either of them
+    int arenaLength = std::max(fileParameters.populationLength, this->m_lambda_nOfParentsSelected);
+    this->m_populationArray.reserve(arenaLength);
+    this->m_descendencyArray.reserve(arenaLength);
+    this->m_parentIndexes.reserve(this->m_lambda_nOfParentsSelected);
 }
 
 // Recombination step
 template <class RepresentationType, class FitnessValueType, class IndividualClass>
-arrayOfIndividuals SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
-recombineParents(arrayOfIndividuals parents, int generation)
+void SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
+recombineParents(int generation)
 {
-    // Calls the corresponding recombination method (read from the file)
-    return onePointRecombination(parents, generation);
+    // The descendency arena holds one son per parent. Its memory was reserved on the constructor, so
+    // resizing it does not allocate memory
+    this->m_descendencyArray.resize(this->m_parentIndexes.size());
+
+    // Each pair of sons has its own random number generator
+    this->seedPairRandomGenerators(generation);
+
+    // Individuals whose rows are permutations can only exchange whole rows. The rest of them use the
+    // crossover method of the configuration file
+    int crossoverMethod = IndividualClass::ROW_PERMUTATION_GENOTYPE ? 2 : m_fileParameters.crossoverMethod;
+
+    // For each pair of parents (in parallel)
+    this->m_threadPool->parallelFor(this->getNumberOfPairs(), [this, crossoverMethod, generation](int pair)
+    {
+        int i = 2*pair;
+        RandomNumberGenerator& rng = this->m_pairRandomGenerators[pair];
+
+        // References to each parent (on the current population) and to the place of each son (on
+        // the descendency arena)
+        const IndividualClass& parent1 = this->m_populationArray[this->m_parentIndexes[i]];
+        const IndividualClass& parent2 = this->m_populationArray[this->m_parentIndexes[i+1]];
+        IndividualClass& son1 = this->m_descendencyArray[i];
+        IndividualClass& son2 = this->m_descendencyArray[i+1];
+
+        // Each son starts as a copy of one parent
+        son1 = parent1;
+        son2 = parent2;
+
+        // Do the crossover in function of m_pc_crossoverProb. If there is not crossover, parents
+        // are returned
+        float randomProb = get_random_float_0_to_1(rng);
+        if(randomProb > this->m_pc_crossoverProb)
+            return;
+
+        // Genes are exchanged between both sons on the positions of the mask
+        std::array<uint8_t, SUDOKU_CELLS> mask;
+        buildCrossoverMask(crossoverMethod, rng, mask);
+        son1.blendGenotype(parent2, mask);
+        son2.blendGenotype(parent1, mask);
+
+        // Sets the inicial generation of each son so as to calculate their age
+        son1.setCreationGen(generation);
+        son2.setCreationGen(generation);
+    });
 }
 
-// Implementation of one point recombination
+// Builds the mask of the genes exchanged by a crossover
 template <class RepresentationType, class FitnessValueType, class IndividualClass>
-arrayOfIndividuals SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
-onePointRecombination(arrayOfIndividuals parents, int generation)
+void SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
+buildCrossoverMask(int crossoverMethod, RandomNumberGenerator& rng, std::array<uint8_t, SUDOKU_CELLS>& mask) const
 {
-    // Initialized the array to be returned
-    arrayOfIndividuals sons;
-    sons.reserve(parents.size());
+    // Positions after the last gene are never exchanged
+    mask.fill(0);
+    int lengthOfTheGenotype = this->m_lengthOfTheGenotype;
 
-    // Gets the crossover point randomly
-    int crossoverPoint = get_random_integer(1, this->m_lengthOfTheGenotype);
+    // If all cells are fixed, there is no gene to be exchanged
+    if(lengthOfTheGenotype == 0)
+        return;
 
-    // For each pair of parents
-    for(int i=0; i<parents.size(); i+=2)
+    // One point: genes from a random crossover point to the end
+    if(crossoverMethod == 0)
     {
-        // Copies each parent to parent1 or parent2
-        IndividualClass parent1 = parents.at(i);
-        IndividualClass parent2 = parents.at(i+1);
-
-        // Do the crossover in function of m_pc_crossoverProb
-        float randomProb = get_random_float_0_to_1();
-        if(randomProb <= this->m_pc_crossoverProb)
+        int crossoverPoint = get_random_integer(rng, 1, lengthOfTheGenotype);
+        for(int gene = 0; gene < lengthOfTheGenotype; gene++)
+            mask[gene] = -static_cast<uint8_t>(gene >= crossoverPoint);
+    }
+    // Uniform: each gene with probability 0.5 (one random bit per gene)
+    else if(crossoverMethod == 1)
+    {
+        uint64_t randomBits[2] = {rng.next(), rng.next()};
+        for(int gene = 0; gene < lengthOfTheGenotype; gene++)
+            mask[gene] = -static_cast<uint8_t>((randomBits[gene >> 6] >> (gene & 63)) & 1);
+    }
+    // Unit-wise: all the genes of each row, col or subgrid with probability 0.5 (bit u of
+    // exchangedUnits), so that units that are already right are inherited as a whole
+    else
+    {
+        int unitType = crossoverMethod - 2;
+        int unitsOffset = unitType * SUDOKU_UNIT_SIZE;
+        int exchangedUnits = get_random_integer(rng, 0, (1 << SUDOKU_UNIT_SIZE) - 1);
+        for(int gene = 0; gene < lengthOfTheGenotype; gene++)
         {
-            // Intializes sons 1 and 2
-            IndividualClass son1;
-            IndividualClass son2;
-
-            // Copies the genotype of parent1 to son2 and the one of parent2 to son1
-            std::vector<RepresentationType> parent1_genotype = parent1.getGenotype();
-            std::vector<RepresentationType> parent2_genotype = parent2.getGenotype();
-            std::vector<RepresentationType> son1_genotype = parent2_genotype;
-            std::vector<RepresentationType> son2_genotype = parent1_genotype;
-
-            // Copies the genotype of parent1 to son1 until the crossover point and vice versa
-            std::copy(parent1_genotype.begin(), parent1_genotype.begin()+crossoverPoint, son1_genotype.begin());
-            std::copy(parent2_genotype.begin(), parent2_genotype.begin()+crossoverPoint, son2_genotype.begin());
-
-            // Sets the generated genotypes to each son
-            son1.updateGenotype(son1_genotype);
-            son2.updateGenotype(son2_genotype);
-
-            #if defined DEBUG_MODE_ON
-                // Checks and corrects each son (only while debugging)
-                if(!son1.checkFixedModified(this->m_initialSudokuCells))
-                {
-                    son1.correctFixedModified(this->m_initialSudokuCells);
-                    std::cout << "bad recombination\n";
-                }
-                
-                if(!son2.checkFixedModified(this->m_initialSudokuCells))
-                {
-                    son2.correctFixedModified(this->m_initialSudokuCells);
-                    std::cout << "bad recombination\n";
-                }
-            #endif
-                
-            // Calculates the fitnes value of the generated sons
-            son1.calculateFitnessValue();
-            son2.calculateFitnessValue();
-
-            // Updates the legal values of each cell of the generated sons
-            son1.updateLegalValuesOfEachCell();
-            son2.updateLegalValuesOfEachCell();
-
-            // Sets the inicial generation of each son so as to calculate their age
-            son1.setCreationGen(generation);
-            son2.setCreationGen(generation);
-
-            // Adds them to the sons array
-            sons.emplace_back(son1);
-            sons.emplace_back(son2);
+            int unit = m_puzzleContext->freeCellUnits[gene][unitType] - unitsOffset;
+            mask[gene] = -static_cast<uint8_t>((exchangedUnits >> unit) & 1);
         }
+    }
+}
+
+// Evaluation step
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+void SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
+evaluatePopulationDescendency()
+{
+    arrayOfIndividuals& descendency = this->m_descendencyArray;
+
+    // If the fitness values are updated incrementally, all of them are already calculated
+    if(!m_fileParameters.batchFitnessEvaluation)
+        return;
+
+    // Gets the individuals whose fitness value is pending. The ones whose genotype is on the cache
+    // take the fitness value from it instead
+    m_batchIndividuals.clear();
+    int nOfSons = descendency.size();
+    for(int i=0; i<nOfSons; i++)
+    {
+        if(!descendency[i].isFitnessEvaluationPending())
+            continue;
+
+        FitnessValueType cachedFitnessValue;
+        if(m_fitnessCache.lookup(descendency[i].getGenotypeHash(), cachedFitnessValue))
+            descendency[i].setEvaluatedFitnessValue(cachedFitnessValue);
         else
-        {
-            // If there is not crossover, parets are returned
-            sons.emplace_back(parent1);
-            sons.emplace_back(parent2);
-        }
+            m_batchIndividuals.push_back(i);
     }
 
-    return sons;
+    int nOfBoards = m_batchIndividuals.size();
+    if(nOfBoards == 0)
+        return;
+
+    m_batchBoards.resize(SUDOKU_CELLS * nOfBoards);
+    m_batchFitnessValues.resize(nOfBoards);
+
+    // Boards are evaluated in parallel on chunks that fill whole AVX2 registers
+    const int boardsPerChunk = 32;
+    int nOfChunks = (nOfBoards + boardsPerChunk - 1) / boardsPerChunk;
+    this->m_threadPool->parallelFor(nOfChunks, [this, &descendency, nOfBoards, boardsPerChunk](int chunk)
+    {
+        int firstBoard = chunk * boardsPerChunk;
+        int lastBoard = std::min(firstBoard + boardsPerChunk, nOfBoards);
+
+        // Copies their cells to the batch of transposed boards
+        for(int b=firstBoard; b<lastBoard; b++)
+            descendency[m_batchIndividuals[b]].copyCellsToBatch(m_batchBoards.data(), nOfBoards, b);
+
+        // Evaluates all of them at once
+        evaluate_fitness_of_board_range(m_batchBoards.data(), nOfBoards, firstBoard, lastBoard, m_batchFitnessValues.data());
+
+        // Sets the fitness value of each individual
+        for(int b=firstBoard; b<lastBoard; b++)
+            descendency[m_batchIndividuals[b]].setEvaluatedFitnessValue(m_batchFitnessValues[b]);
+    });
+
+    // Stores the new fitness values on the cache
+    if(m_fitnessCache.isEnabled())
+    {
+        for(int b=0; b<nOfBoards; b++)
+            m_fitnessCache.insert(descendency[m_batchIndividuals[b]].getGenotypeHash(), m_batchFitnessValues[b]);
+    }
 }
 
-// Survival selection step
+// Local search step
 template <class RepresentationType, class FitnessValueType, class IndividualClass>
 void SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
-selectSurvivals(arrayOfIndividuals currentPopulationDescendency)
+improveDescendency(int generation)
 {
-    // Initialized the array containing the new population
-    arrayOfIndividuals newPopulation;
+    int nOfSons = this->m_descendencyArray.size();
+    int nOfImprovedSons = std::min(m_fileParameters.localSearchIndividuals, nOfSons);
+    if(nOfImprovedSons <= 0)
+        return;
+
+    // Positions of the best sons (the first ones of the bucket index, so they are not sorted)
+    m_descendencyBucketIndex.build(this->m_descendencyArray, this->m_maximization);
+
+    // Each improved son has its own random number generator, on streams that do not overlap with the
+    // ones of the pairs of sons (seedPairRandomGenerators()), so that results do not depend on the
+    // number of threads
+    m_localSearchRandomGenerators.resize(nOfImprovedSons);
+    for(int i = 0; i < nOfImprovedSons; i++)
+    {
+        uint64_t stream = (static_cast<uint64_t>(generation) << 32) | (1ull << 31) | static_cast<uint64_t>(i);
+        m_localSearchRandomGenerators[i].reseed(this->m_randomSeed, stream);
+    }
+
+    // Improves each of them (in parallel)
+    this->m_threadPool->parallelFor(nOfImprovedSons, [this](int i)
+    {
+        this->m_descendencyArray[m_descendencyBucketIndex.getIndexOfRank(i)].localSearch(m_fileParameters.localSearchSteps,
+            m_fileParameters.localSearchTabuTenure, m_localSearchRandomGenerators[i]);
+    });
+}
 
-    // If it is a generational model, descendency replaces parents
+// Survival selection step
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+void SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
+selectSurvivals()
+{
+    // Calls the corresponding survival selection method
     if(m_fileParameters.generationalModel)
+        survivalSelection_generationalModel();
+    else
+        survivalSelection_steadyStateModel();
+}
+
+// Implementation of the generational model
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+void SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
+survivalSelection_generationalModel()
+{
+    // Calls the corresponding survival strategy
+    switch(m_fileParameters.survivalStrategy)
     {
-        newPopulation = currentPopulationDescendency;
+    case 1:
+        survivalSelection_muPlusLambda();
+        break;
+    case 2:
+        survivalSelection_muCommaLambda();
+        break;
+    default:
+        survivalSelection_descendencyReplacesParents();
+        break;
     }
+    this->invalidateStatistics();
+}
 
-    // If elitism is being applied, the best individual of the previous population is
-    // always on the next population (provided that it is better than all sons)
+// Implementation of the generational replacement (all sons replace all parents)
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+void SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
+survivalSelection_descendencyReplacesParents()
+{
+    // If elitism is being applied, the best parents replace the worst sons
     if(m_fileParameters.elitism)
+        keepElitesOnDescendency();
+
+    // The new population is built on the descendency arena, which is swapped with the current
+    // population
+    this->m_populationArray.swap(this->m_descendencyArray);
+}
+
+// Implementation of the (mu+lambda) strategy
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+void SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
+survivalSelection_muPlusLambda()
+{
+    // Parents and sons compete together, and only the best mu (the length of the population) of them
+    // survive. Positions 0 ... mu-1 of the pool are the parents and the rest are the sons
+    int mu = this->m_populationArray.size();
+    int nOfSons = this->m_descendencyArray.size();
+    m_survivalIndexes.resize(mu + nOfSons);
+    for(int i = 0; i < mu + nOfSons; i++)
+        m_survivalIndexes[i] = i;
+
+    // Only partitions the pool, so that the first mu positions are the best ones (on draws, the
+    // lowest position wins, so parents are kept before equal sons)
+    std::nth_element(m_survivalIndexes.begin(), m_survivalIndexes.begin() + mu, m_survivalIndexes.end(),
+    [this, mu](int a, int b)
+    {
+        FitnessValueType fitnessA = a < mu ? this->m_populationArray[a].getFitnessValue() : this->m_descendencyArray[a - mu].getFitnessValue();
+        FitnessValueType fitnessB = b < mu ? this->m_populationArray[b].getFitnessValue() : this->m_descendencyArray[b - mu].getFitnessValue();
+        if(fitnessA != fitnessB)
+            return this->m_maximization ? fitnessA > fitnessB : fitnessA < fitnessB;
+        return a < b;
+    });
+
+    // There are as many surviving sons as dead parents, so each surviving son is copied in place over
+    // a dead parent (the surviving parents are not moved)
+    int deadParentPosition = mu;
+    for(int i = 0; i < mu; i++)
+    {
+        int survivor = m_survivalIndexes[i];
+        if(survivor < mu)
+            continue;
+
+        while(m_survivalIndexes[deadParentPosition] >= mu)
+            deadParentPosition++;
+        this->m_populationArray[m_survivalIndexes[deadParentPosition]] = this->m_descendencyArray[survivor - mu];
+        deadParentPosition++;
+    }
+}
+
+// Implementation of the (mu,lambda) strategy
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+void SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
+survivalSelection_muCommaLambda()
+{
+    // Only the best mu sons survive. If elitism is being applied, the best parents replace the worst
+    // of those sons
+    int mu = this->m_populationArray.size();
+    int nOfSons = this->m_descendencyArray.size();
+
+    // If there are less sons than mu (lambda < mu), all of them survive and the best mu - lambda
+    // parents fill the rest of the population (as on (mu+lambda)), so that its length does not
+    // change. The best parent always survives, so elitism is not needed
+    if(nOfSons < mu)
     {
-        // Gets the best individual of the current population and its fitness value
-        FitnessValueType currentGenBestFitnessValue = this->getTheBestFitnessValue();
-        IndividualClass bestIndividualOfDescendency = this->getBestIndividualOfDescendency(currentPopulationDescendency);
+        this->getTheBestIndividualIndexes(mu - nOfSons, m_eliteIndexes);
+        for(int eliteIdx : m_eliteIndexes)
+            this->m_descendencyArray.push_back(this->m_populationArray[eliteIdx]);
 
-        // Gets the fitness value of the best individual on descendency
-        FitnessValueType descendencyBestFitnessValue = bestIndividualOfDescendency.getFitnessValue();
+        this->m_populationArray.swap(this->m_descendencyArray);
+        return;
+    }
 
-        // The condition changes whether it is a maximization or minimization
-        if(this->m_maximization)
+    if(nOfSons > mu)
+    {
+        // Partitions the positions of the sons so that the first mu are the best ones, and moves them
+        // to the first mu positions of the descendency arena (in increasing order, so that no son
+        // is overwritten before being moved)
+        getBestIndexes(this->m_descendencyArray, mu, m_survivalIndexes);
+        std::sort(m_survivalIndexes.begin(), m_survivalIndexes.begin() + mu);
+        for(int i = 0; i < mu; i++)
         {
-            // If the best parent is to be put on descendency
-            if(descendencyBestFitnessValue < currentGenBestFitnessValue)
-            {
-                // Choose one son randomly and replace it with the best parent
-                int randomIdx = get_random_integer(0, newPopulation.size()-1);
-                newPopulation[randomIdx] = this->getTheBestIndividual();
-            }
+            if(m_survivalIndexes[i] != i)
+                this->m_descendencyArray[i] = this->m_descendencyArray[m_survivalIndexes[i]];
         }
+        this->m_descendencyArray.resize(mu);
+    }
+
+    if(m_fileParameters.elitism)
+        keepElitesOnDescendency();
+
+    this->m_populationArray.swap(this->m_descendencyArray);
+}
+
+// Top-k elitism
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+void SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
+keepElitesOnDescendency()
+{
+    int nOfSons = this->m_descendencyArray.size();
+
+    // The k best parents (from best to worst, taken from the bucket index) and the k worst sons
+    int nOfElites = std::min({m_fileParameters.numberOfElites, nOfSons, static_cast<int>(this->m_populationArray.size())});
+    if(nOfElites <= 0)
+        return;
+    this->getTheBestIndividualIndexes(nOfElites, m_eliteIndexes);
+    getWorstIndexes(this->m_descendencyArray, nOfSons, nOfElites, m_survivalIndexes);
+
+    // The worst sons are sorted from worst to best, so that the best parent replaces the worst son,
+    // the second best parent replaces the second worst son and so on, while parents are better
+    std::sort(m_survivalIndexes.begin(), m_survivalIndexes.begin() + nOfElites, [this](int a, int b)
+    {
+        FitnessValueType fitnessA = this->m_descendencyArray[a].getFitnessValue();
+        FitnessValueType fitnessB = this->m_descendencyArray[b].getFitnessValue();
+        if(fitnessA != fitnessB)
+            return this->m_maximization ? fitnessA < fitnessB : fitnessA > fitnessB;
+        return a < b;
+    });
+    for(int i = 0; i < nOfElites; i++)
+    {
+        const IndividualClass& elite = this->m_populationArray[m_eliteIndexes[i]];
+        IndividualClass& son = this->m_descendencyArray[m_survivalIndexes[i]];
+        FitnessValueType eliteFitnessValue = elite.getFitnessValue();
+        FitnessValueType sonFitnessValue = son.getFitnessValue();
+        if(this->m_maximization ? eliteFitnessValue <= sonFitnessValue : eliteFitnessValue >= sonFitnessValue)
+            break;
+        son = elite;
+    }
+}
+
+// Positions of the k best individuals of an array
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+void SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
+getBestIndexes(const arrayOfIndividuals& individuals, int k, std::vector<int>& indexes) const
+{
+    // Only partitions the positions, so that the first k ones are the best ones (in any order). On
+    // draws, the lowest position wins, so that results do not depend on the implementation
+    int nOfIndividuals = individuals.size();
+    indexes.resize(nOfIndividuals);
+    for(int i = 0; i < nOfIndividuals; i++)
+        indexes[i] = i;
+    std::nth_element(indexes.begin(), indexes.begin() + k, indexes.end(), [this, &individuals](int a, int b)
+    {
+        FitnessValueType fitnessA = individuals[a].getFitnessValue();
+        FitnessValueType fitnessB = individuals[b].getFitnessValue();
+        if(fitnessA != fitnessB)
+            return this->m_maximization ? fitnessA > fitnessB : fitnessA < fitnessB;
+        return a < b;
+    });
+}
+
+// Positions of the k worst individuals among the first n ones of an array
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+void SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
+getWorstIndexes(const arrayOfIndividuals& individuals, int n, int k, std::vector<int>& indexes) const
+{
+    // The same as getBestIndexes(), but with the opposite order (on draws, the highest position is
+    // the worst one)
+    indexes.resize(n);
+    for(int i = 0; i < n; i++)
+        indexes[i] = i;
+    std::nth_element(indexes.begin(), indexes.begin() + k, indexes.end(), [this, &individuals](int a, int b)
+    {
+        FitnessValueType fitnessA = individuals[a].getFitnessValue();
+        FitnessValueType fitnessB = individuals[b].getFitnessValue();
+        if(fitnessA != fitnessB)
+            return this->m_maximization ? fitnessA < fitnessB : fitnessA > fitnessB;
+        return a > b;
+    });
+}
+
+// Implementation of the steady-state model
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+void SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
+survivalSelection_steadyStateModel()
+{
+    // Each son replaces an individual of the current population in place (the worst one or the loser
+    // of a tournament) if it is not worse than it. Therefore, the best individual is never lost and
+    // elitism is not needed. The worst individual is got from the bucket index, which is updated
+    // (not built again) after each replacement, so each son costs O(F) instead of O(N)
+    for(const IndividualClass& son : this->m_descendencyArray)
+    {
+        int replacedIdx;
+        if(m_fileParameters.steadyStateReplacement == 0)
+            replacedIdx = this->getBucketIndex().getWorstIndex();
         else
-        {
-            // If the best parent is to be put on descendency
-            if(descendencyBestFitnessValue > currentGenBestFitnessValue)
-            {
-                // Choose one son randomly and replace it with the best parent
-                int randomIdx = get_random_integer(0, newPopulation.size()-1);
-                newPopulation[randomIdx] = this->getTheBestIndividual();
-            }
-        }
+            replacedIdx = getReplacementTournamentLoser();
 
+        FitnessValueType sonFitnessValue = son.getFitnessValue();
+        FitnessValueType replacedFitnessValue = this->m_populationArray[replacedIdx].getFitnessValue();
+        if(this->m_maximization ? sonFitnessValue >= replacedFitnessValue : sonFitnessValue <= replacedFitnessValue)
+            this->replaceIndividual(replacedIdx, son);
     }
+}
 
-    // Set the new population on its corresponding member
-    this->m_populationArray = newPopulation;
+// Loser of a replacement tournament
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+int SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
+getReplacementTournamentLoser()
+{
+    // Gamma individuals are chosen randomly (they may be repeated) and the worst of them loses
+    int nOfIndividuals = this->m_populationArray.size();
+    int loserIdx = get_random_integer(this->m_randomGenerator, 0, nOfIndividuals - 1);
+    for(unsigned int i = 1; i < this->m_gamma; i++)
+    {
+        int idx = get_random_integer(this->m_randomGenerator, 0, nOfIndividuals - 1);
+        FitnessValueType fitnessValue = this->m_populationArray[idx].getFitnessValue();
+        FitnessValueType loserFitnessValue = this->m_populationArray[loserIdx].getFitnessValue();
+        if(this->m_maximization ? fitnessValue < loserFitnessValue : fitnessValue > loserFitnessValue)
+            loserIdx = idx;
+    }
+
+    return loserIdx;
 }
 
 // Population initialization step
@@ -241,31 +619,68 @@ template <class RepresentationType, class FitnessValueType, class IndividualClas
 void SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
 initializePopulation()
 {
+    // Generates an individual that only contains the context of the sudoku. The rest of
+    // individuals are clones of it
+    IndividualClass emptyIndividual(0, m_puzzleContext.get(), this->m_fileParameters.mutation_method,
+                                    this->m_fileParameters.batchFitnessEvaluation);
+
+    // Removes the previous individuals (if any), but keeps the memory of the arena
+    this->m_populationArray.clear();
+
     // m_populationLength times:
-    for(int i=0; i < this->m_populationLength; i++)
+    for(unsigned int i=0; i < this->m_populationLength; i++)
     {
-        // Generate a new individual
-        IndividualClass individual(0, this->m_lengthOfTheGenotype, m_initialSudokuCells, this->m_fileParameters.mutation_method);
+        // Append a new individual to m_populationArray and initialize it
+        this->m_populationArray.push_back(emptyIndividual);
+        this->m_populationArray.back().initializeIndividual(this->m_randomGenerator);
+    }
+    this->invalidateStatistics();
 
-        // Initialize it
-        individual.initializeIndividual();
+    // The descendency arena is filled with clones of the empty individual, which will be overwritten
+    // by the sons of each generation
+    this->m_descendencyArray.assign(this->m_lambda_nOfParentsSelected, emptyIndividual);
+}
 
-        // Append it to m_populationArray
-        this->m_populationArray.emplace_back(individual);
-    }
+// Changes the sudoku to be solved
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+void SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
+resetPuzzle(const std::vector<int>& initialSudokuCells, int randomSeed)
+{
+    // Builds the context of the new sudoku
+    m_puzzleContext = std::make_shared<const SudokuPuzzleContext>(initialSudokuCells, m_fileParameters.constraintPropagation);
+    this->m_lengthOfTheGenotype = m_puzzleContext->nOfFreeCells;
+
+    // Seeds the random number generator again
+    m_fileParameters.randomSeed = randomSeed;
+    this->m_randomSeed = randomSeed;
+    this->m_randomGenerator.reseed(randomSeed);
+
+    // Hashes of the previous sudoku mean nothing on the new one
+    m_fitnessCache.clear();
+
+    // Initializes the population on the same arenas
+    initializePopulation();
+}
+
+// Getter of the context of the sudoku
+template <class RepresentationType, class FitnessValueType, class IndividualClass>
+const std::shared_ptr<const SudokuPuzzleContext>& SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
+getPuzzleContext() const
+{
+    return m_puzzleContext;
 }
 
 // Method that returns the best individual of the descendency, providing it as an array
 template <class RepresentationType, class FitnessValueType, class IndividualClass>
-IndividualClass SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
-getBestIndividualOfDescendency(arrayOfIndividuals descendency)
+const IndividualClass& SDK_Population<RepresentationType, FitnessValueType, IndividualClass>::
+getBestIndividualOfDescendency(const arrayOfIndividuals& descendency) const
 {
     // Takes the first individual of descendency
     auto it = descendency.begin();
 
-    // Sets it as the best, as it is the first
+    // Sets it as the best, as it is the first (only an iterator is kept, so it is not copied)
     FitnessValueType bestFitnessValue = it->getFitnessValue();
-    IndividualClass bestIndividual = *it;
+    auto bestIndividual = it;
 
     // Increases the iterator so as to start checking from the second
     it++;
@@ -281,7 +696,7 @@ getBestIndividualOfDescendency(arrayOfIndividuals descendency)
             {
                 // If it is so, it updates it
                 bestFitnessValue = it->getFitnessValue();
-                bestIndividual = *it;
+                bestIndividual = it;
             }
         }
         else
@@ -291,7 +706,7 @@ getBestIndividualOfDescendency(arrayOfIndividuals descendency)
             {
                 // If it is so, it updates it
                 bestFitnessValue = it->getFitnessValue();
-                bestIndividual = *it;
+                bestIndividual = it;
             }
         }
 
@@ -299,5 +714,5 @@ getBestIndividualOfDescendency(arrayOfIndividuals descendency)
     }
 
     // Return the best individual
-    return bestIndividual;
+    return *bestIndividual;
 }
@@ -0,0 +1,83 @@
+#include "sudokuPuzzleContext.hpp"
+#include "utils.hpp" // ALL_SUDOKU_VALUES_MASK, sudoku_value_bit
+#include "constraintPropagation.hpp" // propagate_constraints
+
+// Constructor
+SudokuPuzzleContext::SudokuPuzzleContext(const std::vector<int>& sudokuInitialValues, bool propagateConstraints)
+{
+    nOfFreeCells = 0;
+    nOfPropagatedCells = 0;
+    for(int unit = 0; unit < SUDOKU_UNITS; unit++)
+        initialUnitValueCounts[unit].fill(0);
+
+    for(int cell = 0; cell < SUDOKU_CELLS; cell++)
+        initialValues[cell] = sudokuInitialValues[cell];
+
+    // Candidates of each cell. Without propagation (or if the sudoku has no solution, so that the
+    // genetic algorithm still returns its best individual) all values are candidates
+    std::array<uint16_t, SUDOKU_CELLS> candidates;
+    candidates.fill(ALL_SUDOKU_VALUES_MASK);
+    if(propagateConstraints)
+    {
+        std::array<uint8_t, SUDOKU_CELLS> propagatedValues = initialValues;
+        int nOfDeducedCells = propagate_constraints(propagatedValues, candidates);
+        if(nOfDeducedCells != PROPAGATION_CONTRADICTION)
+        {
+            initialValues = propagatedValues;
+            nOfPropagatedCells = nOfDeducedCells;
+        }
+        else
+            candidates.fill(ALL_SUDOKU_VALUES_MASK);
+    }
+
+    // For each cell, stores whether it is fixed or not
+    for(int cell = 0; cell < SUDOKU_CELLS; cell++)
+    {
+        // The genes of a row start after the genes of the previous rows
+        if(cell % SUDOKU_UNIT_SIZE == 0)
+            rowFirstGene[cell / SUDOKU_UNIT_SIZE] = nOfFreeCells;
+
+        fixedCells[cell] = initialValues[cell] != 0;
+
+        if(fixedCells[cell])
+        {
+            // Fixed cells are counted on their units
+            geneOfCell[cell] = -1;
+            for(int i = 0; i < 3; i++)
+                initialUnitValueCounts[sudokuTables.cellUnits[cell][i]][initialValues[cell]]++;
+        }
+        else
+        {
+            // Not fixed cells become a gene of the genotype
+            geneOfCell[cell] = nOfFreeCells;
+            freeCells[nOfFreeCells] = cell;
+            freeCellUnits[nOfFreeCells] = sudokuTables.cellUnits[cell];
+            nOfFreeCells++;
+        }
+    }
+
+    rowFirstGene[SUDOKU_UNIT_SIZE] = nOfFreeCells;
+
+    // Bitmask of the fixed values on each unit
+    std::array<uint16_t, SUDOKU_UNITS> fixedValuesOnUnit;
+    for(int unit = 0; unit < SUDOKU_UNITS; unit++)
+    {
+        fixedValuesOnUnit[unit] = 0;
+        for(int value = 1; value <= 9; value++)
+            if(initialUnitValueCounts[unit][value] > 0)
+                fixedValuesOnUnit[unit] |= sudoku_value_bit(value);
+    }
+
+    // Legal values of each gene on its row, col and subgrid, merged with a logical AND (and restricted
+    // to the candidates left by propagation) and with a logical OR
+    for(int gene = 0; gene < nOfFreeCells; gene++)
+    {
+        const auto& units = freeCellUnits[gene];
+        uint16_t posibleRowValues = ALL_SUDOKU_VALUES_MASK & ~fixedValuesOnUnit[units[0]];
+        uint16_t posibleColValues = ALL_SUDOKU_VALUES_MASK & ~fixedValuesOnUnit[units[1]];
+        uint16_t posibleSubgridValues = ALL_SUDOKU_VALUES_MASK & ~fixedValuesOnUnit[units[2]];
+
+        initialLegalValues[gene] = posibleRowValues & posibleColValues & posibleSubgridValues & candidates[freeCells[gene]];
+        initialRelaxedLegalValues[gene] = posibleRowValues | posibleColValues | posibleSubgridValues;
+    }
+}
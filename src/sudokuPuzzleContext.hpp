@@ -0,0 +1,69 @@
+#pragma once // Multiple inclusion guardian
+
+#include <array> // std::array
+#include <bitset> // std::bitset
+#include <vector> // std::vector
+#include <cstdint> // uint8_t, uint16_t
+
+#include "sudokuTables.hpp" // sudokuTables
+
+/*
+
+SudokuPuzzleContext struct:
+
+Immutable information of the sudoku to be solved, calculated only once and shared by pointer by all
+individuals (SDK_Individual, sudokuProblemIndividual.hpp) of a population. Therefore, individuals only
+need to store the values of the not fixed cells (free cells). It has the following members:
+
+    - initialValues: value of each cell of the sudoku read from the file (0 if it is not fixed)
+    - fixedCells: whether each cell is fixed (given) or not
+    - nOfFreeCells: number of not fixed cells, that is to say, the length of the genotype
+    - freeCells: cell (0-80) of each gene of the genotype (only the first nOfFreeCells are used)
+    - geneOfCell: gene of each cell (-1 if the cell is fixed)
+    - rowFirstGene: first gene of each row. As genes follow the order of the cells, the genes of the
+      row r are rowFirstGene[r] ... rowFirstGene[r+1]-1
+    - freeCellUnits: row, col and subgrid units (numbered as in sudokuTables.hpp) of each gene
+    - initialUnitValueCounts: number of times each value appears on each unit taking into account
+      only the fixed cells
+    - initialLegalValues: bitmask of the values that are legal for each gene taking into account only
+      the fixed cells (legal on its row AND col AND subgrid)
+    - initialRelaxedLegalValues: the same, but the values only need to be legal on its row OR col
+      OR subgrid (used by mutation method 2 when initialLegalValues is empty)
+    - nOfPropagatedCells: number of cells deduced by constraint propagation (constraintPropagation.hpp)
+      that have been fixed
+
+If constraint propagation is applied, the cells it deduces are fixed as if they had been read from the
+file, and the legal values of each gene are only the candidates left by the propagation. If the sudoku
+is solved by propagation, the genotype is empty.
+
+*/
+
+struct SudokuPuzzleContext
+{
+    // Values of the sudoku read from the file and whether each cell is fixed or not
+    std::array<uint8_t, SUDOKU_CELLS> initialValues;
+    std::bitset<SUDOKU_CELLS> fixedCells;
+
+    // Not fixed cells (genes) and the gene of each cell
+    int nOfFreeCells;
+    std::array<uint8_t, SUDOKU_CELLS> freeCells;
+    std::array<int8_t, SUDOKU_CELLS> geneOfCell;
+    std::array<uint8_t, SUDOKU_UNIT_SIZE + 1> rowFirstGene;
+
+    // Units of each gene
+    std::array<std::array<uint8_t, 3>, SUDOKU_CELLS> freeCellUnits;
+
+    // Counts of each value on each unit taking into account only the fixed cells
+    std::array<std::array<uint8_t, 10>, SUDOKU_UNITS> initialUnitValueCounts;
+
+    // Legal values of each gene taking into account only the fixed cells
+    std::array<uint16_t, SUDOKU_CELLS> initialLegalValues;
+    std::array<uint16_t, SUDOKU_CELLS> initialRelaxedLegalValues;
+
+    // Number of cells deduced by constraint propagation
+    int nOfPropagatedCells;
+
+    // Constructor that calculates every member from the 81 values read from the file, applying
+    // constraint propagation to them first if propagateConstraints is true
+    SudokuPuzzleContext(const std::vector<int>& sudokuInitialValues, bool propagateConstraints = false);
+};
@@ -2,12 +2,10 @@
 
 #include <iostream> // std::cout, std::endl
 #include <fstream> // std::ifstream
-#include <sstream> // std::stringstream
-#include <iterator> //std::vector<>::iterator
 #include <string> // std::string
 #include <vector> // std::vector
 
-#include "utils.hpp" // split_string
+#include "sudokuStreamReader.hpp" // SudokuStreamReader
 
 /*
 
@@ -31,6 +29,9 @@ Class that reads the sudoku to be solved from a file. The structure of the file
     9,8,4,0,6,5,2,0,0
     0,2,6,0,8,0,0,0,9
 
+The sudoku can also be written on one line of 81 characters, as the files are read with
+SudokuStreamReader (sudokuStreamReader.hpp).
+
 */
 
 class SudokuReader
@@ -68,30 +69,18 @@ SudokuReader::SudokuReader(std::string sudokuFilePath)
     // Saves the path
     m_sudokuFilePath = sudokuFilePath;
 
-    // Initializes a std::string that will contain each line of the text file
-    std::string sudokuLine;
-
     // Creates a file stream with the text file
     std::ifstream sudokuFile(m_sudokuFilePath);
 
     // If the file is readable
     if(sudokuFile.is_open())
     {
-        // For each line in file
-        while(std::getline(sudokuFile, sudokuLine))
+        // Reads the first sudoku of the file (in any of the formats of SudokuStreamReader)
+        SudokuStreamReader sudokuStreamReader(sudokuFile);
+        if(!sudokuStreamReader.readNextSudoku(m_readSudoku))
         {
-            // Split it with commas
-            std::vector<std::string> splitedString;
-            split_string(sudokuLine, splitedString, ',');
-
-            // Each value in splitedString is a sudoku cell value
-            auto it = splitedString.begin();
-            while(it != splitedString.end())
-            {
-                // Appends it to m_readSudoku member
-                m_readSudoku.push_back(std::stoi(*it));
-                it++;
-            }
+            std::cout << "The sudoku file does not contain any sudoku\n";
+            m_readSudoku = {-1};
         }
     }
     else
@@ -0,0 +1,329 @@
+#pragma once // Multiple inclusion guardian
+
+#include "sudokuProblemIndividual.hpp" // SDK_Individual
+#include <array> // std::array
+#include <cstdint> // uint8_t, uint16_t
+
+/*
+
+SDK_RowPermutationIndividual class:
+
+A class template that represents an individual of the sudoku problem whose rows are always a permutation
+of the values that are missing on them, so that no value is ever repeated on a row and the search space
+is much smaller. It inherits from SDK_Individual (sudokuProblemIndividual.hpp), with the same genotype
+(the values of the not fixed cells), unit counts and incremental fitness value, and it only changes the
+operators so that they keep the permutations:
+
+    - initialization: the missing values of each row are placed randomly on its not fixed cells,
+      preferring on each cell the values that are legal on it taking into account the fixed cells
+    - mutation: with probability pm, two not fixed cells of each row swap their values (the first one
+      is chosen among the cells whose value is repeated on their col or subgrid, if there are any)
+    - local search: swaps of two not fixed cells of a row instead of changes of one of them
+    - recombination: whole rows are exchanged between parents (see SDK_Population, which checks
+      ROW_PERMUTATION_GENOTYPE)
+
+The fitness value is the same as SDK_Individual's, but as rows never have repeated values, only cols and
+subgrids are taken into account when it is calculated from scratch.
+
+It has the same template parameters as SDK_Individual (sudokuProblemIndividual.hpp):
+
+    template <class RepresentationType, class FitnessValueType>
+
+*/
+
+template <class RepresentationType, class FitnessValueType>
+class SDK_RowPermutationIndividual : public SDK_Individual<RepresentationType, FitnessValueType>
+{
+
+// METHODS //
+
+public:
+
+    // Rows are permutations, so recombination must exchange whole rows
+    static constexpr bool ROW_PERMUTATION_GENOTYPE = true;
+
+    // CONSTRUCTORS AND DESTRUCTOR //
+
+    // Constructor with the same parameters as SDK_Individual's
+    SDK_RowPermutationIndividual(int creationGen, const SudokuPuzzleContext* puzzleContext, char mutation_method,
+                                 bool deferredFitnessEvaluation = false):
+    SDK_Individual<RepresentationType, FitnessValueType>(creationGen, puzzleContext, mutation_method, deferredFitnessEvaluation) {}
+
+    // Default constructor and destructor
+    SDK_RowPermutationIndividual(){}
+    ~SDK_RowPermutationIndividual() {}
+
+    // IMPLEMENTATION OF THE PURE VIRTUAL METHODS OF Individual (individual.hpp) //
+
+    // Method that initializes the individual with a permutation of the missing values of each row
+    void initializeIndividual(RandomNumberGenerator& rng);
+
+    // Method that calculates the fitness value of the individual (only cols and subgrids)
+    void calculateFitnessValue();
+
+    // Method that mutates the individual swapping two cells of each row with probability pm
+    void mutateIndividual(float pm, RandomNumberGenerator& rng);
+
+    // Local search (min-conflicts with a tabu list, as SDK_Individual's) that swaps a gene repeated on
+    // its col or subgrid with the gene of its row that reduces the fitness value the most
+    void localSearch(int maxSteps, int tabuTenure, RandomNumberGenerator& rng);
+
+private:
+
+    // Swaps the values of two genes updating the unit counts and the fitness value incrementally
+    void swapGeneValues(int gene1, int gene2);
+};
+
+// Initializes the individual
+template <class RepresentationType, class FitnessValueType>
+void SDK_RowPermutationIndividual<RepresentationType, FitnessValueType>::
+initializeIndividual(RandomNumberGenerator& rng)
+{
+    const SudokuPuzzleContext& context = *this->m_puzzleContext;
+
+    for(int row = 0; row < SUDOKU_UNIT_SIZE; row++)
+    {
+        // Values that are not fixed on the row
+        std::array<uint8_t, SUDOKU_UNIT_SIZE> missingValues;
+        int nOfMissingValues = 0;
+        for(int value = 1; value <= 9; value++)
+            if(context.initialUnitValueCounts[ROW_UNITS_OFFSET + row][value] == 0)
+                missingValues[nOfMissingValues++] = value;
+
+        // Assigns them to the genes of the row in random order, each gene taking a random missing value
+        // that is legal on it taking into account the fixed cells (if any is left). If the fixed cells
+        // repeat a value, there are more missing values than genes, and some of them are not used
+        int firstGene = context.rowFirstGene[row];
+        int nOfGenes = context.rowFirstGene[row + 1] - firstGene;
+        std::array<uint8_t, SUDOKU_UNIT_SIZE> genesOfRow;
+        for(int i = 0; i < nOfGenes; i++)
+            genesOfRow[i] = firstGene + i;
+
+        for(int i = 0; i < nOfGenes; i++)
+        {
+            // Next gene (Fisher-Yates shuffle of the genes of the row)
+            std::swap(genesOfRow[i], genesOfRow[rng.nextInteger(i, nOfGenes - 1)]);
+            int gene = genesOfRow[i];
+
+            // Missing values not assigned yet are missingValues[i] ... missingValues[nOfMissingValues-1]
+            uint16_t remainingValues = 0;
+            for(int j = i; j < nOfMissingValues; j++)
+                remainingValues |= sudoku_value_bit(missingValues[j]);
+
+            uint16_t legalValues = remainingValues & context.initialLegalValues[gene];
+            int value = get_random_element_bitmask(rng, legalValues != 0 ? legalValues : remainingValues);
+
+            // Removes the value from the remaining ones
+            for(int j = i; j < nOfMissingValues; j++)
+                if(missingValues[j] == value)
+                    std::swap(missingValues[i], missingValues[j]);
+            this->m_genotype[gene] = value;
+        }
+    }
+
+    // Calculates the hash, the unit counts and the fitness value of the initialized individual
+    this->calculateGenotypeHash();
+    this->calculateFitnessValue();
+}
+
+// Calculates the fitness value of the individual
+template <class RepresentationType, class FitnessValueType>
+void SDK_RowPermutationIndividual<RepresentationType, FitnessValueType>::
+calculateFitnessValue()
+{
+    // All units are counted, as row counts are also used by the incremental updates of setGeneValue()
+    this->countValuesOfEachUnit();
+
+    // Repetitions of each value on each col and subgrid (see SDK_Individual::calculateFitnessValue())
+    int fitness_ci = 0;
+    int fitness_si = 0;
+    for(int i = 0; i < SUDOKU_UNIT_SIZE; i++)
+    {
+        for(int value = 0; value <= 9; value++)
+        {
+            int colCount = this->m_unitValueCounts[COL_UNITS_OFFSET + i][value];
+            int subgridCount = this->m_unitValueCounts[SUBGRID_UNITS_OFFSET + i][value];
+
+            fitness_ci += colCount * (colCount - 1);
+            fitness_si += subgridCount * (subgridCount - 1);
+        }
+    }
+
+    this->m_fitnessValue = static_cast<FitnessValueType>(fitness_ci + fitness_si) / 2.0f;
+    this->m_pendingFitnessEvaluation = false;
+}
+
+// Mutation of an individual
+template <class RepresentationType, class FitnessValueType>
+void SDK_RowPermutationIndividual<RepresentationType, FitnessValueType>::
+mutateIndividual(float pm, RandomNumberGenerator& rng)
+{
+    const SudokuPuzzleContext& context = *this->m_puzzleContext;
+
+    // Genes whose value is repeated on their col or subgrid, calculated before the mutation so that the
+    // order in which rows are mutated does not matter (on deferred fitness evaluation, unit counts are
+    // not updated by setGeneValue())
+    if(this->m_outdatedUnitCounts)
+        this->countValuesOfEachUnit();
+
+    std::array<bool, SUDOKU_CELLS> conflictedGenes;
+    for(unsigned int gene = 0; gene < this->m_lengthOfTheGenotype; gene++)
+    {
+        int geneValue = this->m_genotype[gene];
+        const auto& units = context.freeCellUnits[gene];
+        conflictedGenes[gene] = this->m_unitValueCounts[units[1]][geneValue] > 1 || this->m_unitValueCounts[units[2]][geneValue] > 1;
+    }
+
+    // Random values that decide whether each row is mutated, all of them generated at once
+    std::array<float, SUDOKU_UNIT_SIZE> randomValues;
+    rng.nextFloats(randomValues.data(), SUDOKU_UNIT_SIZE);
+
+    for(int row = 0; row < SUDOKU_UNIT_SIZE; row++)
+    {
+        int firstGene = context.rowFirstGene[row];
+        int nOfGenes = context.rowFirstGene[row + 1] - firstGene;
+        if(nOfGenes < 2 || randomValues[row] > pm)
+            continue;
+
+        // The first gene is a random one among the repeated ones of the row (if there are not, among
+        // all genes of the row), and the second one any other gene of the row
+        std::array<uint8_t, SUDOKU_UNIT_SIZE> conflictedGenesOfRow;
+        int nOfConflictedGenes = 0;
+        for(int gene = firstGene; gene < firstGene + nOfGenes; gene++)
+            if(conflictedGenes[gene])
+                conflictedGenesOfRow[nOfConflictedGenes++] = gene;
+
+        int gene1 = nOfConflictedGenes > 0 ? conflictedGenesOfRow[rng.nextInteger(0, nOfConflictedGenes - 1)]
+                                           : firstGene + rng.nextInteger(0, nOfGenes - 1);
+        int gene2 = firstGene + rng.nextInteger(0, nOfGenes - 2);
+        if(gene2 >= gene1)
+            gene2++;
+
+        int value1 = this->m_genotype[gene1];
+        this->setGeneValue(gene1, this->m_genotype[gene2]);
+        this->setGeneValue(gene2, value1);
+    }
+}
+
+// Swaps the values of two genes
+template <class RepresentationType, class FitnessValueType>
+void SDK_RowPermutationIndividual<RepresentationType, FitnessValueType>::
+swapGeneValues(int gene1, int gene2)
+{
+    int value1 = this->m_genotype[gene1];
+    this->updateGeneValue(gene1, this->m_genotype[gene2]);
+    this->updateGeneValue(gene2, value1);
+}
+
+// Local search
+template <class RepresentationType, class FitnessValueType>
+void SDK_RowPermutationIndividual<RepresentationType, FitnessValueType>::
+localSearch(int maxSteps, int tabuTenure, RandomNumberGenerator& rng)
+{
+    /*
+
+    OPERATION: the same as SDK_Individual::localSearch(), but each step swaps a gene whose value is
+    repeated on its col or subgrid with another gene of its row, so that the row remains a permutation.
+    The change of the fitness value of each swap is obtained applying it and undoing it, which only
+    updates the counts of the cols and subgrids of both genes. Both genes get the values they leave
+    as tabu.
+
+    */
+
+    const SudokuPuzzleContext& context = *this->m_puzzleContext;
+
+    // Unit counts and the fitness value must be up to date, and they are updated incrementally during
+    // the search
+    if(this->m_pendingFitnessEvaluation)
+        this->calculateFitnessValue();
+    else if(this->m_outdatedUnitCounts)
+        this->countValuesOfEachUnit();
+
+    // Best individual found during the search
+    FitnessValueType bestFitnessValue = this->m_fitnessValue;
+    std::array<RepresentationType, SUDOKU_CELLS> bestGenotype = this->m_genotype;
+    std::array<std::array<uint8_t, 10>, SUDOKU_UNITS> bestUnitValueCounts = this->m_unitValueCounts;
+
+    // Step until which each value of each gene is tabu
+    std::array<int, SUDOKU_CELLS * 10> tabuUntilStep;
+    tabuUntilStep.fill(0);
+
+    std::array<uint8_t, SUDOKU_CELLS> conflictedGenes;
+    for(int step = 1; step <= maxSteps && this->m_fitnessValue > 0; step++)
+    {
+        // Genes whose value is repeated on their col or subgrid
+        int nOfConflictedGenes = 0;
+        for(unsigned int gene = 0; gene < this->m_lengthOfTheGenotype; gene++)
+        {
+            int geneValue = this->m_genotype[gene];
+            const auto& units = context.freeCellUnits[gene];
+            if(this->m_unitValueCounts[units[1]][geneValue] > 1 || this->m_unitValueCounts[units[2]][geneValue] > 1)
+                conflictedGenes[nOfConflictedGenes++] = gene;
+        }
+
+        if(nOfConflictedGenes == 0)
+            break;
+
+        int gene = conflictedGenes[rng.nextInteger(0, nOfConflictedGenes - 1)];
+        int row = sudokuTables.cellRow[context.freeCells[gene]];
+        int geneValue = this->m_genotype[gene];
+
+        // Gene of the row with the best swap among the not tabu ones
+        FitnessValueType currentFitnessValue = this->m_fitnessValue;
+        int chosenGene = -1;
+        FitnessValueType chosenFitnessValue = 0;
+        int nOfTies = 0;
+        for(int other = context.rowFirstGene[row]; other < context.rowFirstGene[row + 1]; other++)
+        {
+            int otherValue = this->m_genotype[other];
+            if(other == gene || otherValue == geneValue)
+                continue;
+
+            swapGeneValues(gene, other);
+            FitnessValueType swappedFitnessValue = this->m_fitnessValue;
+            swapGeneValues(gene, other);
+
+            // Tabu swaps are only allowed if they lead to the best individual found (aspiration)
+            bool isTabu = tabuUntilStep[gene * 10 + otherValue] >= step || tabuUntilStep[other * 10 + geneValue] >= step;
+            if(isTabu && swappedFitnessValue >= bestFitnessValue)
+                continue;
+
+            if(nOfTies == 0 || swappedFitnessValue < chosenFitnessValue)
+            {
+                chosenGene = other;
+                chosenFitnessValue = swappedFitnessValue;
+                nOfTies = 1;
+            }
+            else if(swappedFitnessValue == chosenFitnessValue && rng.nextInteger(0, nOfTies++) == 0)
+                chosenGene = other;
+        }
+
+        // The fitness value is restored exactly after undoing each swap
+        this->m_fitnessValue = currentFitnessValue;
+        if(chosenGene < 0)
+            continue;
+
+        tabuUntilStep[gene * 10 + geneValue] = step + tabuTenure;
+        tabuUntilStep[chosenGene * 10 + this->m_genotype[chosenGene]] = step + tabuTenure;
+        swapGeneValues(gene, chosenGene);
+
+        if(this->m_fitnessValue < bestFitnessValue)
+        {
+            bestFitnessValue = this->m_fitnessValue;
+            bestGenotype = this->m_genotype;
+            bestUnitValueCounts = this->m_unitValueCounts;
+        }
+    }
+
+    // The individual ends up as the best one found
+    if(this->m_fitnessValue > bestFitnessValue)
+    {
+        this->m_fitnessValue = bestFitnessValue;
+        this->m_genotype = bestGenotype;
+        this->m_unitValueCounts = bestUnitValueCounts;
+        this->calculateGenotypeHash();
+    }
+
+    this->m_pendingFitnessEvaluation = false;
+    this->m_outdatedUnitCounts = false;
+}
@@ -0,0 +1,59 @@
+#include "sudokuStreamReader.hpp"
+
+#include <iostream> // std::cerr, std::endl
+
+#include "sudokuTables.hpp" // SUDOKU_CELLS, SUDOKU_UNIT_SIZE
+#include "utils.hpp" // parse_sudoku_line, parse_sudoku_comma_row
+
+// Constructor
+SudokuStreamReader::SudokuStreamReader(std::istream& inputStream):
+m_inputStream(inputStream), m_lineNumber(0)
+{
+}
+
+// Reads the next sudoku
+bool SudokuStreamReader::readNextSudoku(std::vector<int>& cells)
+{
+    cells.resize(SUDOKU_CELLS);
+
+    // Number of rows of a sudoku with commas that have already been read
+    int nOfCommaRows = 0;
+
+    while(std::getline(m_inputStream, m_line))
+    {
+        m_lineNumber++;
+        if(m_line.empty() || m_line[0] == '#' || m_line == "\r")
+            continue;
+
+        // A row of a sudoku with commas
+        if(m_line.find(',') != std::string::npos)
+        {
+            if(parse_sudoku_comma_row(m_line, &cells[nOfCommaRows * SUDOKU_UNIT_SIZE]))
+            {
+                nOfCommaRows++;
+                if(nOfCommaRows == SUDOKU_UNIT_SIZE)
+                    return true;
+                continue;
+            }
+        }
+        // A sudoku on one line (it can not appear in the middle of a sudoku with commas)
+        else if(nOfCommaRows == 0 && parse_sudoku_line(m_line, cells))
+            return true;
+
+        // Otherwise the line is skipped, together with the incomplete sudoku it belongs to
+        std::cerr << "Line " << m_lineNumber << " is not part of a sudoku. It is ignored" << std::endl;
+        nOfCommaRows = 0;
+    }
+
+    // An incomplete sudoku at the end of the stream is ignored
+    if(nOfCommaRows > 0)
+        std::cerr << "The last sudoku is incomplete. It is ignored" << std::endl;
+
+    return false;
+}
+
+// Getter of the number of the last line read
+long SudokuStreamReader::getLineNumber() const
+{
+    return m_lineNumber;
+}
@@ -0,0 +1,62 @@
+#pragma once // Multiple inclusion guardian
+
+#include <istream> // std::istream
+#include <string> // std::string
+#include <vector> // std::vector
+
+/*
+
+SudokuStreamReader class:
+
+Class that reads sudokus one after another from a stream (a file or stdin), without storing more than
+the one that is being read. Each sudoku can be written on either of these formats:
+
+    - One line of 81 characters (digits, with '0' or '.' on the empty cells):
+
+    000030004090406070050000380000078003300000690540600020705024000984065200026080009
+
+    - Nine lines of 9 values separated with commas (the format of SudokuReader):
+
+    0,0,0,0,3,0,0,0,4
+    0,9,0,4,0,6,0,7,0
+    ...
+
+Both formats can be mixed on the same stream. Empty lines and lines that start with '#' are ignored,
+and lines that are not part of a sudoku are reported on stderr and skipped, so that one wrong line
+does not stop the processing of a large dataset.
+
+*/
+
+class SudokuStreamReader
+{
+
+// ATTRIBUTES //
+
+private:
+
+    // Stream from which sudokus are read
+    std::istream& m_inputStream;
+
+    // Buffer of the line that is being read (reused for all lines, so that reading does not allocate)
+    std::string m_line;
+
+    // Number of the last line read
+    long m_lineNumber;
+
+// METHODS //
+
+public:
+
+    // Constructor. The stream must exist while the reader is used
+    explicit SudokuStreamReader(std::istream& inputStream);
+
+    // Standard destructor
+    ~SudokuStreamReader() {}
+
+    // Reads the next sudoku and stores its 81 values on cells. Returns false when there are no more
+    // sudokus on the stream
+    bool readNextSudoku(std::vector<int>& cells);
+
+    // Getter of the number of the last line read
+    long getLineNumber() const;
+};
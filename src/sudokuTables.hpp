@@ -0,0 +1,133 @@
+#pragma once // Multiple inclusion guardian
+
+#include <array> // std::array
+#include <cstdint> // uint8_t, uint64_t
+
+/*
+
+SudokuTables struct:
+
+Lookup tables with the static geometry of the sudoku. They are generated at compile time by
+buildSudokuTables() so that hot loops only read flat arrays (no std::set copies nor switch
+statements). All indexes are 0-based:
+
+    - cells are numbered 0-80 (row-major order)
+    - rows, cols and subgrids are numbered 0-8
+    - units are numbered 0-26: rows are units 0-8, cols are units 9-17 and subgrids are units 18-26
+
+It has the following members:
+
+    - cellRow, cellCol and cellSubgrid: the row, col and subgrid to which each cell belongs to
+    - unitCells: the 9 cells that compose each unit
+    - cellUnits: the 3 units (row, col and subgrid) to which each cell belongs to
+    - cellPeers: the 20 cells that share a row, col or subgrid with each cell (the cell excluded)
+    - zobristKeys: a random 64 bits key for each position (0-80) and value (1-9), so that a genotype
+      is hashed as the XOR of the keys of its values (Zobrist hashing) and the hash can be updated
+      in O(1) when a value changes. Keys of the value 0 (empty) are 0
+
+*/
+
+// Number of cells, units, values per unit and peers per cell of a sudoku
+const int SUDOKU_CELLS = 81;
+const int SUDOKU_UNITS = 27;
+const int SUDOKU_UNIT_SIZE = 9;
+const int SUDOKU_PEERS = 20;
+
+// Offsets of the first row, col and subgrid on the units numbering
+const int ROW_UNITS_OFFSET = 0;
+const int COL_UNITS_OFFSET = 9;
+const int SUBGRID_UNITS_OFFSET = 18;
+
+struct SudokuTables
+{
+    // row, col and subgrid of each cell
+    std::array<uint8_t, SUDOKU_CELLS> cellRow;
+    std::array<uint8_t, SUDOKU_CELLS> cellCol;
+    std::array<uint8_t, SUDOKU_CELLS> cellSubgrid;
+
+    // Cells of each unit
+    std::array<std::array<uint8_t, SUDOKU_UNIT_SIZE>, SUDOKU_UNITS> unitCells;
+
+    // Units (row, col and subgrid in this order) of each cell
+    std::array<std::array<uint8_t, 3>, SUDOKU_CELLS> cellUnits;
+
+    // Peers of each cell
+    std::array<std::array<uint8_t, SUDOKU_PEERS>, SUDOKU_CELLS> cellPeers;
+
+    // Zobrist key of each position and value
+    std::array<std::array<uint64_t, 10>, SUDOKU_CELLS> zobristKeys;
+};
+
+// Function that generates all lookup tables at compile time
+constexpr SudokuTables buildSudokuTables()
+{
+    SudokuTables tables{};
+
+    // Number of cells already stored on each unit
+    std::array<int, SUDOKU_UNITS> unitLength{};
+
+    // For each cell, get its row, col and subgrid and append it to its units
+    for(int cell = 0; cell < SUDOKU_CELLS; cell++)
+    {
+        int row = cell / 9;
+        int col = cell % 9;
+        int subgrid = (row / 3) * 3 + col / 3;
+
+        tables.cellRow[cell] = row;
+        tables.cellCol[cell] = col;
+        tables.cellSubgrid[cell] = subgrid;
+
+        tables.cellUnits[cell][0] = ROW_UNITS_OFFSET + row;
+        tables.cellUnits[cell][1] = COL_UNITS_OFFSET + col;
+        tables.cellUnits[cell][2] = SUBGRID_UNITS_OFFSET + subgrid;
+
+        for(int i = 0; i < 3; i++)
+        {
+            int unit = tables.cellUnits[cell][i];
+            tables.unitCells[unit][unitLength[unit]] = cell;
+            unitLength[unit]++;
+        }
+    }
+
+    // For each cell, its peers are all other cells that share a row, col or subgrid with it
+    for(int cell = 0; cell < SUDOKU_CELLS; cell++)
+    {
+        int nOfPeers = 0;
+        for(int other = 0; other < SUDOKU_CELLS; other++)
+        {
+            if(other != cell && (tables.cellRow[other] == tables.cellRow[cell] ||
+                                 tables.cellCol[other] == tables.cellCol[cell] ||
+                                 tables.cellSubgrid[other] == tables.cellSubgrid[cell]))
+            {
+                tables.cellPeers[cell][nOfPeers] = other;
+                nOfPeers++;
+            }
+        }
+    }
+
+    // Zobrist keys are the numbers of a splitmix64 sequence with a fixed seed, so that hashes are the
+    // same on every execution
+    uint64_t splitmixState = 0x5D0C0B1E5EEDULL;
+    for(int position = 0; position < SUDOKU_CELLS; position++)
+    {
+        tables.zobristKeys[position][0] = 0;
+        for(int value = 1; value <= 9; value++)
+        {
+            splitmixState += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = splitmixState;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            tables.zobristKeys[position][value] = z ^ (z >> 31);
+        }
+    }
+
+    return tables;
+}
+
+// Lookup tables of the sudoku (generated at compile time)
+inline constexpr SudokuTables sudokuTables = buildSudokuTables();
+
+// Checks on compile time some values of the tables
+static_assert(sudokuTables.cellSubgrid[80] == 8, "Wrong subgrid table");
+static_assert(sudokuTables.unitCells[SUBGRID_UNITS_OFFSET + 4][4] == 40, "Wrong unit table");
+static_assert(sudokuTables.cellPeers[0][SUDOKU_PEERS-1] == 72, "Wrong peers table");
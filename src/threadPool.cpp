@@ -0,0 +1,100 @@
+#include "threadPool.hpp"
+
+#include <algorithm> // std::max
+
+// Constructor
+ThreadPool::ThreadPool(int nOfThreads):
+m_task(nullptr), m_taskInvoker(nullptr), m_nOfTasks(0), m_nextTask(0), m_nOfBusyWorkers(0), m_jobNumber(0), m_stop(false)
+{
+    // 0 threads means one thread per core
+    if(nOfThreads <= 0)
+        nOfThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    // The calling thread also runs tasks, so only nOfThreads-1 workers are created
+    m_workers.reserve(nOfThreads - 1);
+    for(int i = 0; i < nOfThreads - 1; i++)
+        m_workers.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+// Destructor
+ThreadPool::~ThreadPool()
+{
+    // Wakes up all workers so that they finish
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_startCondition.notify_all();
+
+    for(std::thread& worker : m_workers)
+        worker.join();
+}
+
+// Number of threads that run tasks
+int ThreadPool::getNumberOfThreads() const
+{
+    return m_workers.size() + 1;
+}
+
+// Runs a job on the workers and the calling thread
+void ThreadPool::runJob(int nOfTasks, const void* task, void (*taskInvoker)(const void*, int))
+{
+    // Publishes the job and wakes up the workers
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_task = task;
+        m_taskInvoker = taskInvoker;
+        m_nOfTasks = nOfTasks;
+        m_nextTask = 0;
+        m_nOfBusyWorkers = m_workers.size();
+        m_jobNumber++;
+    }
+    m_startCondition.notify_all();
+
+    // The calling thread also runs tasks
+    runTasks();
+
+    // Waits until all workers have finished the job
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_finishCondition.wait(lock, [this] { return m_nOfBusyWorkers == 0; });
+    m_task = nullptr;
+}
+
+// Loop of each worker
+void ThreadPool::workerLoop()
+{
+    unsigned long lastJobNumber = 0;
+
+    while(true)
+    {
+        // Waits until there is a new job or the pool is destroyed
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_startCondition.wait(lock, [this, lastJobNumber] { return m_stop || m_jobNumber != lastJobNumber; });
+            if(m_stop)
+                return;
+            lastJobNumber = m_jobNumber;
+        }
+
+        runTasks();
+
+        // Notifies the calling thread if it is the last worker that finishes
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_nOfBusyWorkers--;
+            if(m_nOfBusyWorkers == 0)
+                m_finishCondition.notify_one();
+        }
+    }
+}
+
+// Runs tasks of the current job until there are no more left
+void ThreadPool::runTasks()
+{
+    int task = m_nextTask.fetch_add(1);
+    while(task < m_nOfTasks)
+    {
+        m_taskInvoker(m_task, task);
+        task = m_nextTask.fetch_add(1);
+    }
+}
@@ -0,0 +1,107 @@
+#pragma once // Multiple inclusion guardian
+
+#include <vector> // std::vector
+#include <thread> // std::thread
+#include <mutex> // std::mutex, std::unique_lock
+#include <condition_variable> // std::condition_variable
+#include <atomic> // std::atomic
+
+/*
+
+ThreadPool class:
+
+A pool of threads that are created only once and run independent tasks in parallel. Its only way of
+being used is parallelFor(), which runs task(0), task(1), ..., task(nOfTasks-1) and waits until all of
+them have finished:
+
+    threadPool.parallelFor(nOfTasks, [&](int task) { ... });
+
+Tasks are taken dynamically by the workers and by the calling thread, so they must not depend on each
+other nor on the thread that runs them (for instance, each task must use its own random number
+generator). That way, the result is the same regardless of the number of threads.
+
+A pool of 1 thread does not create any worker, and tasks are run on the calling thread.
+
+parallelFor() is a template on the type of the task, and the workers only keep a pointer to it and a
+pointer to a function that calls it, so running a job never allocates memory (a std::function would
+allocate to hold the captures of most lambdas on every call).
+
+*/
+
+class ThreadPool
+{
+
+// ATRIBUTES //
+
+private:
+
+    // Worker threads (the calling thread is not included)
+    std::vector<std::thread> m_workers;
+
+    // Synchronization between the calling thread and the workers
+    std::mutex m_mutex;
+    std::condition_variable m_startCondition;
+    std::condition_variable m_finishCondition;
+
+    // Current job: the task (and the function that calls it with its real type), the number of
+    // tasks, the next task to be taken and the number of workers that have not finished it yet
+    const void* m_task;
+    void (*m_taskInvoker)(const void*, int);
+    int m_nOfTasks;
+    std::atomic<int> m_nextTask;
+    int m_nOfBusyWorkers;
+
+    // Number of jobs started so far (workers use it to know whether there is a new job) and whether
+    // workers must finish
+    unsigned long m_jobNumber;
+    bool m_stop;
+
+// METHODS //
+
+public:
+
+    // Constructor that creates nOfThreads-1 workers (0 means one thread per core)
+    explicit ThreadPool(int nOfThreads = 1);
+    // Destructor that stops and joins the workers
+    ~ThreadPool();
+
+    // A pool can not be copied
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Number of threads that run tasks (workers + calling thread)
+    int getNumberOfThreads() const;
+
+    // Runs task(0) ... task(nOfTasks-1) in parallel and waits until all of them have finished
+    template <class Task>
+    void parallelFor(int nOfTasks, const Task& task);
+
+private:
+
+    // Runs a job on the workers and the calling thread and waits until it has finished
+    void runJob(int nOfTasks, const void* task, void (*taskInvoker)(const void*, int));
+
+    // Loop of each worker
+    void workerLoop();
+
+    // Runs tasks of the current job until there are no more left
+    void runTasks();
+};
+
+// Runs all tasks in parallel
+template <class Task>
+void ThreadPool::parallelFor(int nOfTasks, const Task& task)
+{
+    // Without workers (or with only one task) tasks are run on the calling thread
+    if(m_workers.empty() || nOfTasks <= 1)
+    {
+        for(int i = 0; i < nOfTasks; i++)
+            task(i);
+        return;
+    }
+
+    runJob(nOfTasks, &task, [](const void* taskPointer, int i)
+    {
+        (*static_cast<const Task*>(taskPointer))(i);
+    });
+}
@@ -1,43 +1,72 @@
 #include "utils.hpp"
 
-// Takes the RandomGenerator defined in main.cpp
-extern std::mt19937 RandomGenerator;
-
-// Funciton that returns a number between 1 and 9 randomly
-int get_random_number_1_to_9()
+// Function that returns a random value from a (not empty) bitmask of sudoku values
+int get_random_element_bitmask(RandomNumberGenerator& rng, uint16_t mask)
 {
-    std::uniform_int_distribution<> uniform_int_dist(1, 9);
-    return uniform_int_dist(RandomGenerator);
-}
+    // Gets a random position among the set bits of the mask
+    int position = get_random_integer(rng, 0, count_values_bitmask(mask) - 1);
 
-// Function that return a float betwen 0 and 1 randomly
-float get_random_float_0_to_1()
-{
-    std::uniform_real_distribution<> uniform_real_dist(0, 1);
-    return uniform_real_dist(RandomGenerator);
+    // Clears the lowest set bit position times, so that the chosen one becomes the lowest
+    for(int j = 0; j<position; j++)
+    {
+        mask &= mask - 1;
+    }
+
+    // The index of the lowest set bit is the value
+    return __builtin_ctz(mask);
 }
 
-// Function that returns a random integer, providin the upper and lower limits
-int get_random_integer(int lower, int upper)
+// Function that reads a sudoku written on one line of 81 characters
+bool parse_sudoku_line(const std::string& line, std::vector<int>& cells)
 {
-    std::uniform_int_distribution<> uniform_int_dist(lower, upper);
-    return uniform_int_dist(RandomGenerator);
+    cells.resize(81);
+
+    // Reads each character of the line, ignoring the final carriage return of Windows files
+    int nOfCells = 0;
+    for(char character : line)
+    {
+        if(character == '\r')
+            continue;
+        if(nOfCells == 81)
+            return false;
+
+        if(character >= '1' && character <= '9')
+            cells[nOfCells++] = character - '0';
+        else if(character == '0' || character == '.')
+            cells[nOfCells++] = 0;
+        else
+            return false;
+    }
+
+    return nOfCells == 81;
 }
 
-// Function that return a random element from a std::set of integers
-int get_random_element_setOfIntegers(std::set<int> container)
+// Function that reads a row of a sudoku written as 9 values separated with commas
+bool parse_sudoku_comma_row(const std::string& line, int* rowCells)
 {
-    // Gets a random idx of the set
-    int position = get_random_integer(0, container.size() - 1);
-
-    // As std::set<>::iterator is not random access, it must be incremented
-    // on a loop
-    auto set_iter = container.begin();
-    for(int j = 0; j<position; j++)
+    // Reads each character of the line, ignoring spaces and the final carriage return of Windows files
+    int nOfCells = 0;
+    bool expectingValue = true;
+    for(char character : line)
     {
-        set_iter++;
+        if(character == ' ' || character == '\t' || character == '\r')
+            continue;
+
+        if(character == ',')
+        {
+            // Two commas without a value between them
+            if(expectingValue)
+                return false;
+            expectingValue = true;
+        }
+        else if(character >= '0' && character <= '9' && expectingValue && nOfCells < 9)
+        {
+            rowCells[nOfCells++] = character - '0';
+            expectingValue = false;
+        }
+        else
+            return false;
     }
 
-    // Return the value of the std::set on position
-    return (*set_iter);
-}
\ No newline at end of file
+    return nOfCells == 9 && !expectingValue;
+}
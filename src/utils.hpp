@@ -2,12 +2,25 @@
 
 #include <string> // std::string
 #include <sstream> // std::stringstream
-#include <random> // random distributions
-#include <iterator> // std::set<>::iterator
-#include <set> // std::set
+#include <vector> // std::vector
+#include "randomNumberGenerator.hpp" // RandomNumberGenerator
+#include <cstdint> // uint16_t
 
-// Declares the RandomGenerator as extern, as it is being initialized on utils.cpp
-extern std::mt19937 RandomGenerator;
+// Bitmask with the bits 1-9 set, that is to say, all values of a sudoku cell. Sets of sudoku
+// values are represented as bitmasks where bit v is set if the value v belongs to the set
+const uint16_t ALL_SUDOKU_VALUES_MASK = 0x3FE;
+
+// Function that returns the bitmask that only contains the value provided
+inline uint16_t sudoku_value_bit(int value)
+{
+    return static_cast<uint16_t>(1u << value);
+}
+
+// Function that returns the number of values contained on a bitmask
+inline int count_values_bitmask(uint16_t mask)
+{
+    return __builtin_popcount(mask);
+}
 
 // Function template that stplits an string with a delimiter and returns the
 // result on cont
@@ -22,26 +35,42 @@ void split_string(const std::string& str, Container& cont, char delim)
     }
 }
 
+// Random functions. All of them receive the generator (stream) that must be used, as there is
+// not a global one
+
 // Function template that returns a random index from a container
 template<typename Container>
-int select_random_item(Container container)
+int select_random_item(RandomNumberGenerator& rng, const Container& container)
 {
-    std::uniform_int_distribution<> uniform_int_dist(0, container.size()-1);
-    int random_idx = uniform_int_dist(RandomGenerator);
-
-    return random_idx;
+    return rng.nextInteger(0, container.size()-1);
 }
 
-// Declaration of some other functions defines in utils.cpp
-
 // Funciton that returns a number between 1 and 9 randomly
-int get_random_number_1_to_9();
+inline int get_random_number_1_to_9(RandomNumberGenerator& rng)
+{
+    return rng.nextInteger(1, 9);
+}
 
 // Function that return a float betwen 0 and 1 randomly
-float get_random_float_0_to_1();
+inline float get_random_float_0_to_1(RandomNumberGenerator& rng)
+{
+    return rng.nextFloat();
+}
 
 // Function that returns a random integer, providin the upper and lower limits
-int get_random_integer(int lower, int upper);
+inline int get_random_integer(RandomNumberGenerator& rng, int lower, int upper)
+{
+    return rng.nextInteger(lower, upper);
+}
+
+// Declaration of some other functions defines in utils.cpp
+
+// Function that returns a random value from a (not empty) bitmask of sudoku values
+int get_random_element_bitmask(RandomNumberGenerator& rng, uint16_t mask);
 
-// Function that return a random element from a std::set of integers
-int get_random_element_setOfIntegers(std::set<int> container);
\ No newline at end of file
+// Function that reads a sudoku written on one line of 81 characters (digits, with '0' or '.' on
+// the empty cells) and stores its 81 values on cells. Returns false if the line is not a sudoku
+bool parse_sudoku_line(const std::string& line, std::vector<int>& cells);
+// Function that reads a row of a sudoku written as 9 values separated with commas (with 0 on the
+// empty cells) and stores them on rowCells[0] ... rowCells[8]. Returns false if the line is not a row
+bool parse_sudoku_comma_row(const std::string& line, int* rowCells);
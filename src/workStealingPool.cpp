@@ -0,0 +1,85 @@
+#include "workStealingPool.hpp"
+
+#include <thread> // std::thread
+#include <algorithm> // std::max, std::min
+
+// Constructor
+WorkStealingPool::WorkStealingPool(int nOfWorkers)
+{
+    // 0 workers means one worker per core
+    if(nOfWorkers <= 0)
+        nOfWorkers = std::max(1u, std::thread::hardware_concurrency());
+
+    m_nOfWorkers = nOfWorkers;
+    for(int worker = 0; worker < m_nOfWorkers; worker++)
+        m_queues.emplace_back(new WorkerQueue());
+}
+
+// Getter for the number of workers
+int WorkStealingPool::getNumberOfWorkers() const
+{
+    return m_nOfWorkers;
+}
+
+// Runs all tasks
+void WorkStealingPool::run(int nOfTasks, const std::function<void(int, int)>& task)
+{
+    // Distributes the tasks among the workers in consecutive blocks
+    int tasksPerWorker = (nOfTasks + m_nOfWorkers - 1) / m_nOfWorkers;
+    for(int worker = 0; worker < m_nOfWorkers; worker++)
+    {
+        int firstTask = worker * tasksPerWorker;
+        int lastTask = std::min(firstTask + tasksPerWorker, nOfTasks);
+        for(int i = firstTask; i < lastTask; i++)
+            m_queues[worker]->tasks.push_back(i);
+    }
+
+    // Worker 0 is the calling thread
+    std::vector<std::thread> workerThreads;
+    for(int worker = 1; worker < m_nOfWorkers; worker++)
+        workerThreads.emplace_back(&WorkStealingPool::workerLoop, this, worker, std::cref(task));
+    workerLoop(0, task);
+
+    for(std::thread& workerThread : workerThreads)
+        workerThread.join();
+}
+
+// Loop of each worker
+void WorkStealingPool::workerLoop(int worker, const std::function<void(int, int)>& task)
+{
+    // As tasks do not create new tasks, the worker finishes when there are no tasks on any queue
+    int taskIndex;
+    while(popTask(worker, taskIndex) || stealTask(worker, taskIndex))
+        task(worker, taskIndex);
+}
+
+// Takes a task from the back of the queue of the worker
+bool WorkStealingPool::popTask(int worker, int& task)
+{
+    WorkerQueue& queue = *m_queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if(queue.tasks.empty())
+        return false;
+
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    return true;
+}
+
+// Takes a task from the front of the queue of another worker
+bool WorkStealingPool::stealTask(int thief, int& task)
+{
+    // Tries the rest of workers, starting from the next one
+    for(int i = 1; i < m_nOfWorkers; i++)
+    {
+        WorkerQueue& queue = *m_queues[(thief + i) % m_nOfWorkers];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if(queue.tasks.empty())
+            continue;
+
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
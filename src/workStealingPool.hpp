@@ -0,0 +1,70 @@
+#pragma once // Multiple inclusion guardian
+
+#include <vector> // std::vector
+#include <deque> // std::deque
+#include <mutex> // std::mutex
+#include <memory> // std::unique_ptr
+#include <functional> // std::function
+
+#include "cacheAlignedAllocator.hpp" // CACHE_LINE_SIZE
+
+/*
+
+WorkStealingPool class:
+
+A pool of workers that run many independent tasks of different duration (for instance, solving a
+sudoku, which can take from a few generations to thousands of them). Tasks are distributed among the
+queues of the workers in blocks, and each worker takes the tasks of its own queue from the back. When
+its queue is empty, it steals tasks from the front of the queues of the rest of workers, so that no
+worker is idle while there are tasks left:
+
+    workStealingPool.run(nOfTasks, [&](int worker, int task) { ... });
+
+The worker that runs each task is provided to it, so that tasks can reuse the resources of the worker
+(for instance, a population).
+
+*/
+
+class WorkStealingPool
+{
+
+// ATRIBUTES //
+
+private:
+
+    // Queue of tasks of a worker. Each one is on its own cache lines so that workers do not
+    // invalidate each other's cache
+    struct alignas(CACHE_LINE_SIZE) WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<int> tasks;
+    };
+
+    // Number of workers and their queues
+    int m_nOfWorkers;
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+
+// METHODS //
+
+public:
+
+    // Constructor that receives the number of workers (0 means one worker per core)
+    explicit WorkStealingPool(int nOfWorkers = 0);
+
+    // Getter for the number of workers
+    int getNumberOfWorkers() const;
+
+    // Runs task(worker, 0) ... task(worker, nOfTasks-1) and waits until all of them have finished
+    void run(int nOfTasks, const std::function<void(int, int)>& task);
+
+private:
+
+    // Loop of each worker
+    void workerLoop(int worker, const std::function<void(int, int)>& task);
+
+    // Takes a task from the back of the queue of the worker
+    bool popTask(int worker, int& task);
+
+    // Takes a task from the front of the queue of another worker
+    bool stealTask(int thief, int& task);
+};
@@ -0,0 +1,178 @@
+#include <iostream> // std::cout, std::endl
+#include <string> // std::string
+#include <vector> // std::vector
+#include <functional> // std::function
+#include <atomic> // std::atomic
+#include <cstdlib> // std::malloc, std::free, std::aligned_alloc
+#include <new> // operator new, std::bad_alloc, std::align_val_t
+
+#include "src/sudokuProblemPopulation.hpp" // SDK_Population
+#include "src/sudokuProblemIndividual.hpp" // SDK_Individual
+#include "src/geneticAlgorithm.hpp" // GeneticAlgorithm
+#include "src/fileParameters.hpp" // FileParameters
+
+/*
+
+Generation allocation test:
+
+Checks that, once the population has been initialized, running a generation does not allocate memory
+proportional to the length of the population (no population is copied and every buffer is reused
+between generations). The global operator new is replaced with a version that counts the allocations,
+and for each configuration the same number of generations is run with a small and a large population
+(after a few warm-up generations, so that buffers reach their final capacity). The test fails if the
+large population allocates more than the small one on any configuration.
+
+It is built and run with:
+
+    make test
+
+*/
+
+// Number of allocations done since the start of the program
+static std::atomic<long> nOfAllocations(0);
+
+// Replacements of the global operator new and operator delete that count the allocations
+void* operator new(std::size_t size)
+{
+    nOfAllocations++;
+    void* pointer = std::malloc(size == 0 ? 1 : size);
+    if(!pointer)
+        throw std::bad_alloc();
+    return pointer;
+}
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    nOfAllocations++;
+    std::size_t alignedSize = (size + static_cast<std::size_t>(alignment) - 1) / static_cast<std::size_t>(alignment) * static_cast<std::size_t>(alignment);
+    void* pointer = std::aligned_alloc(static_cast<std::size_t>(alignment), alignedSize == 0 ? static_cast<std::size_t>(alignment) : alignedSize);
+    if(!pointer)
+        throw std::bad_alloc();
+    return pointer;
+}
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
+
+// Types of the individual, the population and the genetic algorithm (the same as main.cpp)
+typedef SDK_Individual<uint8_t, int> IndividualType;
+typedef SDK_Population<uint8_t, int, IndividualType> PopulationType;
+typedef GeneticAlgorithm<PopulationType, IndividualType, FileParameters> GeneticAlgorithmType;
+
+// Number of warm-up generations and of generations whose allocations are counted
+const int WARM_UP_GENERATIONS = 10;
+const int COUNTED_GENERATIONS = 50;
+
+// Parameters of the configuration file that are not changed by the tested configurations (the rest of
+// them are 0)
+FileParameters getBaseParameters(int populationLength)
+{
+    FileParameters fileParameters{};
+    fileParameters.randomSeed = 42;
+    fileParameters.populationLength = populationLength;
+    fileParameters.logEachXGenerations = 100;
+    fileParameters.maximizationProblem = false;
+    fileParameters.numberOfThreads = 1;
+    fileParameters.parentSelectionMethod = 0;
+    fileParameters.lambda_nOfParentsSelected = populationLength;
+    fileParameters.gamma_tournamentSelection = 2;
+    fileParameters.p_bestParentSelectedProb = 0.7f;
+    fileParameters.excludingTournament = false;
+    fileParameters.rankSelectionPressure = 1.5f;
+    fileParameters.truncationProportion = 0.5f;
+    fileParameters.pc_crossoverProb = 0.9f;
+    fileParameters.pm_mutationProb = 0.3f;
+    fileParameters.mutation_method = 2;
+    fileParameters.generationalModel = true;
+    fileParameters.elitism = true;
+    fileParameters.numberOfElites = 1;
+    return fileParameters;
+}
+
+// Runs the generations of a configuration and returns the allocations done per counted generation
+double countAllocationsPerGeneration(const FileParameters& fileParameters, const std::vector<int>& sudokuCells)
+{
+    GeneticAlgorithmType geneticAlgorithm(fileParameters, sudokuCells);
+    geneticAlgorithm.initializePopulation();
+
+    for(int i = 0; i < WARM_UP_GENERATIONS; i++)
+        geneticAlgorithm.runOneGeneration();
+
+    long allocationsBefore = nOfAllocations;
+    for(int i = 0; i < COUNTED_GENERATIONS; i++)
+        geneticAlgorithm.runOneGeneration();
+    long allocationsAfter = nOfAllocations;
+
+    return static_cast<double>(allocationsAfter - allocationsBefore) / COUNTED_GENERATIONS;
+}
+
+int main()
+{
+    // A sudoku with many free cells, so that it is not solved during the test
+    const std::string sudoku = "038000060540000200001090300860040070400083500007000040386009004020460030000007080";
+    std::vector<int> sudokuCells;
+    for(char cell : sudoku)
+        sudokuCells.push_back(cell - '0');
+
+    // Configurations tested (each one changes the base parameters)
+    struct Configuration
+    {
+        std::string name;
+        std::function<void(FileParameters&)> apply;
+    };
+    const std::vector<Configuration> configurations = {
+        {"incremental evaluation, tournament, generational", [](FileParameters&) {}},
+        {"batch evaluation", [](FileParameters& f)
+            { f.batchFitnessEvaluation = true; }},
+        {"batch evaluation with cache, 4 threads", [](FileParameters& f)
+            { f.batchFitnessEvaluation = true; f.fitnessCacheSize = 4096; f.numberOfThreads = 4; }},
+        {"constraint propagation, row-wise crossover", [](FileParameters& f)
+            { f.constraintPropagation = true; f.crossoverMethod = 2; }},
+        {"local search", [](FileParameters& f)
+            { f.localSearchIndividuals = 2; f.localSearchSteps = 1000; f.localSearchTabuTenure = 2; }},
+        {"uniform crossover, linear rank, (mu+lambda)", [](FileParameters& f)
+            { f.crossoverMethod = 1; f.parentSelectionMethod = 1; f.survivalStrategy = 1; }},
+        {"subgrid crossover, stochastic universal sampling, 5 elites", [](FileParameters& f)
+            { f.crossoverMethod = 4; f.parentSelectionMethod = 2; f.numberOfElites = 5; }},
+        {"truncation, (mu,lambda)", [](FileParameters& f)
+            { f.parentSelectionMethod = 3; f.survivalStrategy = 2; }},
+        {"steady-state, tournament replacement", [](FileParameters& f)
+            { f.generationalModel = false; f.steadyStateReplacement = 1; f.lambda_nOfParentsSelected = 2; }},
+    };
+
+    const int smallPopulationLength = 50;
+    const int largePopulationLength = 1000;
+
+    bool passed = true;
+    for(const Configuration& configuration : configurations)
+    {
+        FileParameters smallParameters = getBaseParameters(smallPopulationLength);
+        FileParameters largeParameters = getBaseParameters(largePopulationLength);
+        configuration.apply(smallParameters);
+        configuration.apply(largeParameters);
+
+        double smallAllocations = countAllocationsPerGeneration(smallParameters, sudokuCells);
+        double largeAllocations = countAllocationsPerGeneration(largeParameters, sudokuCells);
+
+        bool configurationPassed = largeAllocations <= smallAllocations;
+        passed = passed && configurationPassed;
+
+        std::cout << (configurationPassed ? "PASSED" : "FAILED") << " " << configuration.name << ": "
+                  << smallAllocations << " allocations per generation with " << smallPopulationLength << " individuals, "
+                  << largeAllocations << " with " << largePopulationLength << std::endl;
+    }
+
+    return passed ? 0 : 1;
+}